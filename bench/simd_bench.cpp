@@ -0,0 +1,211 @@
+// simd_bench.cpp
+// Times the Analytics hot loops as they were before SimdKernels (bounds-
+// checked getClosePrice calls, two-pass mean/stddev) against the scalar
+// and dispatched (AVX2/NEON) kernels, and checks that all three agree.
+// Usage: simd_bench [prices]
+#include "../include/Analytics.h"
+#include "../include/SimdKernels.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cstdlib>
+
+using namespace std;
+
+static const int REPEATS = 5;               // Best of this many runs
+static const double TOLERANCE = 1e-12;      // Relative, for the mean/variance sums
+
+static double seconds() {
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ===== Original loops (as in Analytics before the kernels) =====
+
+static vector<double> originalDailyReturns(const Stock* stock) {
+    vector<double> returns;
+    int dataSize = stock->getDataSize();
+    
+    for (int i = 1; i < dataSize; i++) {
+        double today = stock->getClosePrice(i);
+        double yesterday = stock->getClosePrice(i - 1);
+        
+        if (yesterday != 0) {
+            double dailyReturn = ((today - yesterday) / yesterday) * 100.0;
+            returns.push_back(dailyReturn);
+        }
+    }
+    return returns;
+}
+
+static void originalMeanStdDev(const vector<double>& data, double& mean, double& stdDev) {
+    double sum = 0.0;
+    for (double val : data) {
+        sum += val;
+    }
+    mean = sum / data.size();
+    
+    double variance = 0.0;
+    for (double val : data) {
+        double diff = val - mean;
+        variance += diff * diff;
+    }
+    stdDev = sqrt(variance / data.size());
+}
+
+static double originalMaxDrawdown(const Stock* stock) {
+    int dataSize = stock->getDataSize();
+    if (dataSize < 2) return 0.0;
+    
+    double maxDrawdown = 0.0;
+    double peak = stock->getClosePrice(0);
+    for (int i = 1; i < dataSize; i++) {
+        double currentPrice = stock->getClosePrice(i);
+        if (currentPrice > peak) {
+            peak = currentPrice;
+        }
+        double drawdown = ((peak - currentPrice) / peak) * 100.0;
+        if (drawdown > maxDrawdown) {
+            maxDrawdown = drawdown;
+        }
+    }
+    return maxDrawdown;
+}
+
+// ===== Timing and checks =====
+
+// Best time of REPEATS runs of f, in milliseconds
+template <typename F>
+static double bestTime(F f) {
+    double best = 0.0;
+    for (int run = 0; run < REPEATS; run++) {
+        double start = seconds();
+        f();
+        double elapsed = (seconds() - start) * 1000.0;
+        best = (run == 0) ? elapsed : min(best, elapsed);
+    }
+    return best;
+}
+
+static int failures = 0;
+
+static void check(const string& label, bool ok) {
+    if (!ok) {
+        cout << "  ✗ " << label << " differs" << endl;
+        failures++;
+    }
+}
+
+static bool sameValues(const vector<double>& a, const vector<double>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i] != b[i]) return false;
+    }
+    return true;
+}
+
+static bool near(double a, double b) {
+    return fabs(a - b) <= TOLERANCE * max(1.0, fabs(b));
+}
+
+int main(int argc, char* argv[]) {
+    int numPrices = (argc > 1) ? atoi(argv[1]) : 2000000;
+    if (numPrices < 2) {
+        cout << "Usage: simd_bench [prices >= 2]" << endl;
+        return 1;
+    }
+    
+    // Random walk with drawdowns
+    mt19937_64 generator(7);
+    normal_distribution<double> noise(0.0, 0.015);
+    Stock stock("SIM", "Simulated");
+    BarStore bars;
+    bars.reserve(numPrices);
+    double price = 100.0;
+    for (int i = 0; i < numPrices; i++) {
+        price *= 1.0 + noise(generator);
+        bars.append(i, price, price, price, price, 1000);
+    }
+    stock.appendBars(bars);
+    
+    // Prices with zeros for the skipped-day path of the returns kernel
+    vector<double> gapped(stock.getBars().getCloses().begin(), stock.getBars().getCloses().end());
+    for (size_t i = 3; i < gapped.size(); i += 97) {
+        gapped[i] = 0.0;
+    }
+    
+    const char* kernel = SimdKernels::activeKernel();
+    cout << "Analytics loops over " << numPrices << " prices, best of " << REPEATS << " (ms)" << endl;
+    cout << "Kernel set: " << kernel << endl;
+    
+    // ----- Equivalence: original loops vs scalar kernels vs dispatched kernels -----
+    vector<double> returnsOriginal = originalDailyReturns(&stock);
+    SimdKernels::forceScalar(true);
+    vector<double> returnsScalar = Analytics::calculateDailyReturns(&stock);
+    double drawdownScalar = Analytics::calculateMaxDrawdown(&stock);
+    double meanScalar, varianceScalar;
+    SimdKernels::meanVariance(returnsScalar.data(), returnsScalar.size(), meanScalar, varianceScalar);
+    vector<double> gappedScalar(gapped.size());
+    gappedScalar.resize(SimdKernels::dailyReturns(gapped.data(), gapped.size(), gappedScalar.data()));
+    SimdKernels::forceScalar(false);
+    
+    vector<double> returnsVector = Analytics::calculateDailyReturns(&stock);
+    double drawdownVector = Analytics::calculateMaxDrawdown(&stock);
+    double meanVector, varianceVector;
+    SimdKernels::meanVariance(returnsVector.data(), returnsVector.size(), meanVector, varianceVector);
+    vector<double> gappedVector(gapped.size());
+    gappedVector.resize(SimdKernels::dailyReturns(gapped.data(), gapped.size(), gappedVector.data()));
+    
+    double meanOriginal, stdDevOriginal;
+    originalMeanStdDev(returnsOriginal, meanOriginal, stdDevOriginal);
+    double drawdownOriginal = originalMaxDrawdown(&stock);
+    
+    check("scalar daily returns", sameValues(returnsScalar, returnsOriginal));
+    check(string(kernel) + " daily returns", sameValues(returnsVector, returnsOriginal));
+    check(string(kernel) + " daily returns with zero prices", sameValues(gappedVector, gappedScalar));
+    check("scalar max drawdown", drawdownScalar == drawdownOriginal);
+    check(string(kernel) + " max drawdown", drawdownVector == drawdownOriginal);
+    check("scalar mean", near(meanScalar, meanOriginal));
+    check(string(kernel) + " mean", near(meanVector, meanOriginal));
+    check("scalar stddev", near(sqrt(varianceScalar), stdDevOriginal));
+    check(string(kernel) + " stddev", near(sqrt(varianceVector), stdDevOriginal));
+    
+    // ----- Timing -----
+    double sink = 0.0;
+    double timings[3][3];       // [loop][original, scalar, dispatched]
+    
+    timings[0][0] = bestTime([&] { sink += originalDailyReturns(&stock).size(); });
+    timings[1][0] = bestTime([&] { double m, s; originalMeanStdDev(returnsOriginal, m, s); sink += s; });
+    timings[2][0] = bestTime([&] { sink += originalMaxDrawdown(&stock); });
+    
+    for (int dispatched = 0; dispatched < 2; dispatched++) {
+        SimdKernels::forceScalar(dispatched == 0);
+        int column = dispatched + 1;
+        timings[0][column] = bestTime([&] { sink += Analytics::calculateDailyReturns(&stock).size(); });
+        timings[1][column] = bestTime([&] {
+            double m, v;
+            SimdKernels::meanVariance(returnsOriginal.data(), returnsOriginal.size(), m, v);
+            sink += sqrt(v);
+        });
+        timings[2][column] = bestTime([&] { sink += Analytics::calculateMaxDrawdown(&stock); });
+    }
+    SimdKernels::forceScalar(false);
+    
+    const char* names[3] = {"Daily returns", "Mean + stddev", "Max drawdown"};
+    cout << fixed << setprecision(2);
+    cout << "\nLoop\t\tOriginal\tScalar\t\t" << kernel << "\t\tSpeedup" << endl;
+    cout << "------------------------------------------------------------------------" << endl;
+    for (int i = 0; i < 3; i++) {
+        cout << names[i] << "\t" << timings[i][0] << "\t\t" << timings[i][1] << "\t\t"
+             << timings[i][2] << "\t\t" << timings[i][0] / timings[i][2] << "x" << endl;
+    }
+    if (sink == 0.0) cout << endl;      // Keep the timed results live
+    
+    if (failures > 0) {
+        cout << "\n✗ " << failures << " kernel check(s) failed" << endl;
+        return 1;
+    }
+    cout << "\n✓ Scalar and " << kernel << " kernels match the original loops" << endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+// AlignedVector.h
+#ifndef ALIGNEDVECTOR_H
+#define ALIGNEDVECTOR_H
+
+#include <vector>
+#include <cstddef>
+#include <new>
+
+using namespace std;
+
+// Cache line / AVX-512 friendly alignment for numeric columns
+const size_t COLUMN_ALIGNMENT = 64;
+
+// Allocator returning 64-byte aligned blocks, so column data starts on a
+// cache line and vectorized loops don't need a misaligned prologue.
+template <typename T>
+struct AlignedAllocator {
+    typedef T value_type;
+    
+    AlignedAllocator() {}
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) {}
+    
+    T* allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), align_val_t(COLUMN_ALIGNMENT)));
+    }
+    
+    void deallocate(T* pointer, size_t) {
+        ::operator delete(pointer, align_val_t(COLUMN_ALIGNMENT));
+    }
+    
+    template <typename U>
+    bool operator==(const AlignedAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U>&) const { return false; }
+};
+
+template <typename T>
+using AlignedVector = vector<T, AlignedAllocator<T>>;
+
+// One value per trading day, 0.0 where an indicator isn't defined yet
+typedef AlignedVector<double> Series;
+
+#endif
@@ -4,6 +4,7 @@
 
 #include <vector>
 #include "Stock.h"
+#include "Backtester.h"
 
 using namespace std;
 
@@ -21,9 +22,22 @@ public:
     // Calculate Sharpe Ratio
     static double calculateSharpeRatio(const vector<double>& returns, double riskFreeRate = 0.02);
     
+    // Calculate Sortino Ratio (only downside deviation counts as risk)
+    static double calculateSortinoRatio(const vector<double>& returns, double riskFreeRate = 0.02);
+    
     // Calculate Maximum Drawdown
     static double calculateMaxDrawdown(const Stock* stock);
     
+    // Day-to-day returns of any value series (e.g. a backtest equity curve)
+    static vector<double> calculateReturns(const Series& values);
+    
+    // Percentage of days with an open position, from a backtest trade log
+    // covering numDays days starting at firstDay
+    static double calculateExposure(const vector<Trade>& trades, int numDays, int firstDay = 0);
+    
+    // Traded value divided by the average portfolio value
+    static double calculateTurnover(const vector<Trade>& trades, const Series& equityCurve);
+    
     // Display analytics report for a stock
     static void displayAnalyticsReport(const Stock* stock);
     
@@ -4,6 +4,8 @@
 
 #include "Stock.h"
 #include "Strategy.h"
+#include "BarReader.h"
+#include "ExecutionModel.h"
 #include <vector>
 #include <string>
 
@@ -11,7 +13,7 @@ using namespace std;
 
 struct Trade {
     int day;
-    string type;      // "BUY" or "SELL"
+    TradeSide side;
     double price;
     int shares;
 };
@@ -21,22 +23,80 @@ private:
     Stock* stock;
     Strategy* strategy;
     double startingCash;
+    const vector<int8_t>* presetSignals;  // Optional, see setSignals()
+    const ExecutionModel* execution;      // Optional, see setExecutionModel()
+    
+    // Days run() covers: [rangeStart, rangeEnd), rangeEnd -1 = to the end
+    int rangeStart;
+    int rangeEnd;
+    
+    // Limit/stop order waiting to be filled (execution model only)
+    bool orderPending;
+    TradeSide pendingSide;
+    double pendingTrigger;
+    int pendingDay;
     
     // Results
     double cash;
     int shares;
-    vector<Trade> trades;
+    vector<Trade> trades;       // Capacity for one trade per day is reserved up front
+    Series equityCurve;         // Portfolio value at each day's close (run() only)
     double finalValue;
     double totalReturn;
     int numTrades;
     int winningTrades;
     double maxDrawdown;
+    double totalCommission;
+    double totalSlippage;       // Cost of fills worse than the reference price
+    
+    // Helper: reset results before a run
+    void reset();
+    
+    // Helper: act on one day's signal and track the drawdown.
+    // Returns the portfolio value at the close.
+    double processDay(int day, double currentPrice, int8_t signal, bool& holding, double& buyPrice, double& peak);
+    
+    // Helper: processDay() with costs and order types from the execution model
+    double processDayExecuted(int day, const BarStore& bars, int index, int8_t signal,
+                              bool& holding, double& buyPrice, double& peak);
+    
+    // Helpers: fill an order through the execution model
+    void executeBuy(int day, double price, long long volume, bool withSlippage, bool& holding, double& buyPrice);
+    void executeSell(int day, double price, long long volume, bool withSlippage, bool& holding, double& buyPrice);
+    
+    // Helper: sell anything still held and compute the final results
+    void finish(int lastDay, double lastPrice, long long lastVolume, bool& holding, double& buyPrice);
     
 public:
     Backtester(Stock* s, Strategy* strat, double initialCash = 10000.0);
     
-    // Run the backtest
-    void run();
+    // Swap the strategy between runs (recording storage is reused)
+    void setStrategy(Strategy* strat);
+    
+    // Trading costs and order types. nullptr (the default) fills every
+    // order at the close for free, using the fast path.
+    void setExecutionModel(const ExecutionModel* model);
+    
+    // Only backtest days [startDay, endDay) of the stock (a view, nothing
+    // is copied). Indicators still see the earlier history. endDay -1 =
+    // to the last day. Trade days stay indices into the whole stock.
+    void setRange(int startDay, int endDay);
+    
+    // Use precomputed signals (one SignalFlags value per day) instead of
+    // asking the strategy, e.g. to share one array across many runs
+    void setSignals(const vector<int8_t>* signals);
+    
+    // Run the backtest (verbose = print progress messages)
+    void run(bool verbose = true);
+    
+    // Streaming mode for data that doesn't fit in memory: bars are pulled
+    // from the reader chunk by chunk and appended to the (empty) stock,
+    // which only keeps the most recent windowBars bars. Indicators are
+    // updated incrementally, so the results match run() on the same data.
+    // The strategy must look up its indicators in prepare(). No equity
+    // curve is recorded (it would grow with the data).
+    // Returns false if the stock isn't empty or the bars are out of order.
+    bool runStreaming(BarReader& reader, int windowBars = 1024, bool verbose = true);
     
     // Display results
     void displayResults() const;
@@ -44,6 +104,21 @@ public:
     // Getters
     double getTotalReturn() const;
     double getFinalValue() const;
+    double getMaxDrawdown() const;
+    int getNumTrades() const;
+    int getWinningTrades() const;
+    double getTotalCommission() const;
+    double getTotalSlippage() const;
+    
+    // Recorded run, for analytics
+    const vector<Trade>& getTrades() const;
+    const Series& getEquityCurve() const;
+    
+    // Analytics over the equity curve and trade log (see Analytics)
+    double getSharpeRatio() const;
+    double getSortinoRatio() const;
+    double getExposure() const;
+    double getTurnover() const;
 };
 
 #endif
\ No newline at end of file
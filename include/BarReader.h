@@ -0,0 +1,98 @@
+// BarReader.h
+#ifndef BARREADER_H
+#define BARREADER_H
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include "BarStore.h"
+
+using namespace std;
+
+// Sequential source of bars, read a chunk at a time so a file never has
+// to fit in memory (see Backtester::runStreaming)
+class BarReader {
+public:
+    virtual ~BarReader() {}
+    
+    // Replace chunk's contents with the next (up to) maxBars bars.
+    // Returns the number of bars read, 0 at the end of the data.
+    virtual int readChunk(BarStore& chunk, int maxBars) = 0;
+    
+    // Open a .qlc binary cache or a CSV file (by extension).
+    // Returns nullptr and sets message if the file can't be read.
+    static BarReader* openFile(const string& filename, string& message);
+};
+
+// Reads a CSV file through a fixed-size buffer
+class CSVBarReader : public BarReader {
+private:
+    FILE* file;
+    vector<char> buffer;
+    size_t bufferStart;     // First unparsed byte
+    size_t bufferEnd;       // End of valid data
+    bool endOfFile;
+    int lineNumber;
+    int skippedLines;
+    
+    // Helper: move unparsed bytes to the front and read more
+    void refill();
+    
+public:
+    CSVBarReader(size_t bufferBytes = 1 << 20);
+    ~CSVBarReader();
+    
+    // Not copyable (owns the file)
+    CSVBarReader(const CSVBarReader&) = delete;
+    CSVBarReader& operator=(const CSVBarReader&) = delete;
+    
+    bool open(const string& filename);
+    void close();
+    int readChunk(BarStore& chunk, int maxBars) override;
+    
+    // Malformed lines skipped so far
+    int getSkippedLines() const;
+    
+    // True for lines holding only spaces/tabs
+    static bool isBlankLine(const char* p, const char* lineEnd);
+    
+    // Parse one data line "date,open,high,low,close,volume" in place
+    static bool parseLine(const char* p, const char* lineEnd, int& date, double& open,
+                          double& high, double& low, double& close, long long& volume);
+};
+
+// Reads the columns of a .qlc binary cache file (see PriceCache.h)
+class BinaryBarReader : public BarReader {
+private:
+    FILE* file;
+    uint64_t rows;
+    uint64_t nextRow;
+    
+    // Column buffers for one chunk
+    AlignedVector<int> dates;
+    Series opens;
+    Series highs;
+    Series lows;
+    Series closes;
+    AlignedVector<long long> volumes;
+    
+    // Helper: read `count` values of one column starting at nextRow
+    bool readColumn(int column, size_t valueSize, void* out, size_t count);
+    
+public:
+    BinaryBarReader();
+    ~BinaryBarReader();
+    
+    // Not copyable (owns the file)
+    BinaryBarReader(const BinaryBarReader&) = delete;
+    BinaryBarReader& operator=(const BinaryBarReader&) = delete;
+    
+    bool open(const string& filename);
+    void close();
+    int readChunk(BarStore& chunk, int maxBars) override;
+    
+    uint64_t getRows() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,55 @@
+// BarStore.h
+#ifndef BARSTORE_H
+#define BARSTORE_H
+
+#include "AlignedVector.h"
+
+using namespace std;
+
+// Structure-of-arrays storage for daily bars.
+// Every column is contiguous and 64-byte aligned; dates are stored as
+// days since 1970-01-01 (see DateUtil) instead of strings.
+class BarStore {
+private:
+    AlignedVector<int> dates;
+    Series openPrices;
+    Series highPrices;
+    Series lowPrices;
+    Series closePrices;
+    AlignedVector<long long> volumes;
+    
+public:
+    BarStore();
+    
+    // Capacity
+    void reserve(size_t bars);
+    void clear();
+    
+    // Drop the oldest `count` bars (capacity is kept)
+    void eraseFront(int count);
+    int size() const;
+    bool empty() const;
+    
+    // Add one bar / a block of bars
+    void append(int date, double open, double high, double low, double close, long long volume);
+    void append(const int* date, const double* open, const double* high,
+                const double* low, const double* close, const long long* volume, size_t count);
+    
+    // Single values (no bounds checks)
+    int getDate(int index) const { return dates[index]; }
+    double getOpen(int index) const { return openPrices[index]; }
+    double getHigh(int index) const { return highPrices[index]; }
+    double getLow(int index) const { return lowPrices[index]; }
+    double getClose(int index) const { return closePrices[index]; }
+    long long getVolume(int index) const { return volumes[index]; }
+    
+    // Whole columns
+    const AlignedVector<int>& getDates() const;
+    const Series& getOpens() const;
+    const Series& getHighs() const;
+    const Series& getLows() const;
+    const Series& getCloses() const;
+    const AlignedVector<long long>& getVolumes() const;
+};
+
+#endif
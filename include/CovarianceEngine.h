@@ -0,0 +1,61 @@
+// CovarianceEngine.h
+#ifndef COVARIANCEENGINE_H
+#define COVARIANCEENGINE_H
+
+#include <vector>
+#include <string>
+#include "Stock.h"
+
+using namespace std;
+
+// Daily % returns of many symbols on a shared date index.
+// Row-major [day][symbol] like the PortfolioBacktester matrices, so the
+// symbols of one day are contiguous; rows are padded to a multiple of 8.
+struct ReturnMatrix {
+    vector<string> symbols;
+    vector<int> timeline;               // Date of each row (days since epoch)
+    int numSymbols;
+    int stride;                         // Padded row length
+    AlignedVector<double> returns;      // Centered on each symbol's mean, 0 where missing
+    AlignedVector<double> mask;         // 1.0 where the symbol has a return that day
+    vector<int> observations;           // Returns per symbol
+    bool complete;                      // No missing returns at all
+    
+    int numDays() const { return timeline.size(); }
+};
+
+// N x N result, row-major
+struct CovarianceMatrix {
+    vector<string> symbols;
+    int size;
+    bool correlation;           // Correlations instead of covariances
+    vector<double> values;      // 0.0 for pairs with too few common days
+};
+
+// Covariance / correlation of many return series.
+// The symbol x symbol product is split into 64 x 64 tiles (upper triangle
+// only) that run in parallel; each tile walks the days in chunks small
+// enough to stay in cache. With missing dates every pair uses only the
+// days on which both symbols have a return (pairwise complete).
+class CovarianceEngine {
+public:
+    // A day's return needs a close on that day and on the previous
+    // timeline day, so gaps and late listings become missing values
+    static ReturnMatrix alignReturns(const vector<Stock*>& stocks);
+    
+    // Population covariance of daily % returns (as in Analytics), or the
+    // correlation if `correlation` is set
+    static CovarianceMatrix compute(const ReturnMatrix& data, bool correlation = false,
+                                    int minObservations = 20, int numThreads = 0);
+    
+    // Print the matrix (first maxSymbols symbols)
+    static void displayMatrix(const CovarianceMatrix& matrix, int maxSymbols = 10);
+    
+private:
+    // Helper: fill one tile of the result
+    static void computeTile(const ReturnMatrix& data, const AlignedVector<double>& squares,
+                            const vector<double>& sumSquares, int rowStart, int columnStart, bool correlation, int minObservations,
+                            vector<double>& values);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,27 @@
+// DateUtil.h
+#ifndef DATEUTIL_H
+#define DATEUTIL_H
+
+#include <string>
+
+using namespace std;
+
+// Conversions between "YYYY-MM-DD" text and days since 1970-01-01
+class DateUtil {
+public:
+    // Parse an ISO date, returns false if the text isn't YYYY-MM-DD.
+    // A time after it ("2024-01-02 09:31:00", "2024-01-02T09:31") is
+    // accepted and dropped: bars are stored by day, so intraday bars of
+    // one session share a date.
+    static bool parseDate(const char* begin, const char* end, int& days);
+    static bool parseDate(const string& text, int& days);
+    
+    // Format days since epoch as YYYY-MM-DD
+    static string formatDate(int days);
+    
+    // Calendar <-> day number
+    static int daysFromCivil(int year, int month, int day);
+    static void civilFromDays(int days, int& year, int& month, int& day);
+};
+
+#endif
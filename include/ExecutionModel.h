@@ -0,0 +1,74 @@
+// ExecutionModel.h
+#ifndef EXECUTIONMODEL_H
+#define EXECUTIONMODEL_H
+
+#include <cstdint>
+
+using namespace std;
+
+enum TradeSide : int8_t {
+    TRADE_BUY,
+    TRADE_SELL
+};
+
+inline const char* tradeSideName(TradeSide side) {
+    return (side == TRADE_BUY) ? "BUY" : "SELL";
+}
+
+// How a strategy signal is turned into an order
+enum OrderType : int8_t {
+    ORDER_MARKET,   // Filled at the signal day's close (plus slippage)
+    ORDER_LIMIT,    // Buy below / sell above the close, filled on a later bar's low/high
+    ORDER_STOP      // Buy above / sell below the close, filled on a later bar's high/low
+};
+
+// Trading costs and order handling for Backtester.
+// The default model is free and fills market orders at the close, like a
+// backtest without a model.
+class ExecutionModel {
+private:
+    // Commissions
+    double fixedCommission;     // $ per trade
+    double percentCommission;   // Fraction of traded value
+    
+    // Slippage = slippageRate + impactRate * (shares / bar volume)
+    double slippageRate;
+    double impactRate;
+    
+    // Order types
+    OrderType buyOrderType;
+    OrderType sellOrderType;
+    double orderOffset;         // Limit/stop distance from the close (fraction)
+    int orderExpiryDays;        // Unfilled limit/stop orders are cancelled after this
+    
+public:
+    ExecutionModel();
+    
+    // Setup
+    void setCommission(double fixedPerTrade, double fractionOfValue);
+    void setSlippage(double baseRate, double volumeImpact);
+    void setOrderTypes(OrderType buyType, OrderType sellType, double offset = 0.01, int expiryDays = 5);
+    
+    // Commission for a trade of `shares` at `price`
+    double commission(int shares, double price) const;
+    
+    // Price after slippage: buys pay more, sells receive less
+    double slippedPrice(TradeSide side, double price, int shares, long long volume) const;
+    
+    // Most shares cash can buy at price, including commission and
+    // (if withSlippage) slippage
+    int affordableShares(double cash, double price, long long volume, bool withSlippage) const;
+    
+    // Trigger price of a limit/stop order placed at `close`
+    double triggerPrice(TradeSide side, double close) const;
+    
+    // Check a resting limit/stop order against one bar.
+    // Gaps through the trigger fill at the open.
+    bool tryFill(TradeSide side, double trigger, double open, double high, double low, double& fillPrice) const;
+    
+    // Getters
+    OrderType getOrderType(TradeSide side) const;
+    int getOrderExpiryDays() const;
+};
+
+#endif
\ No newline at end of file
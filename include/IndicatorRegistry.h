@@ -0,0 +1,107 @@
+// IndicatorRegistry.h
+#ifndef INDICATORREGISTRY_H
+#define INDICATORREGISTRY_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include "AlignedVector.h"
+#include "Indicators.h"
+
+using namespace std;
+
+// Identifies a cached series, e.g. ("SMA", {20}) or ("BB_UPPER", {20, 2})
+struct IndicatorKey {
+    string name;
+    vector<double> params;
+    
+    bool operator<(const IndicatorKey& other) const;
+};
+
+// A cached series plus the rolling state needed to extend it when bars
+// are appended (only the members used by its indicator are touched)
+struct IndicatorEntry {
+    Series values;
+    RollingSum sum;             // SMA
+    RollingVariance variance;   // STDDEV
+    RollingRSI rsi;             // RSI
+    int firstValid;             // Index of the first defined value (earlier ones are 0)
+    
+    IndicatorEntry(int period);
+};
+
+// Computes indicator series on demand and caches them by (name, params).
+// Composite indicators are built from cached building blocks, so e.g.
+// SMA(20) is computed once and shared by Bollinger(20) and STDDEV(20).
+//
+// Supported indicators and parameters:
+//   SMA {period}                 EMA {period}
+//   STDDEV {period}              MOMENTUM {period}
+//   RSI {period}
+//   BB_UPPER {period, numStdDev} BB_MIDDLE {period}
+//   BB_LOWER {period, numStdDev}
+//   MACD {fast, slow}            MACD_SIGNAL {fast, slow, signal}
+//   MACD_HIST {fast, slow, signal}
+//
+// get() is thread-safe. Series are computed outside the lock, so threads
+// asking for different series don't wait on each other.
+//
+// extend() brings every cached series up to date after bars are appended,
+// in O(1) per series and bar.
+class IndicatorRegistry {
+private:
+    map<IndicatorKey, IndicatorEntry> cache;
+    Series emptySeries;
+    mutable mutex cacheMutex;
+    
+    // Helper: extend entry.values from its current size to closes.size()
+    // (an empty entry is computed from scratch)
+    bool compute(const IndicatorKey& key, const Series& closes, IndicatorEntry& entry, string& message);
+    
+    // Helper: check parameter count and that periods are positive
+    static bool checkParams(const IndicatorKey& key, int count, int numPeriods, string& message);
+    
+    // Helper: 0 for series built from prices, higher for series built
+    // from other cached series (extended after their inputs)
+    static int dependencyLevel(const string& name);
+    
+    // Helper: index of a new series' first defined value (warm-up bars)
+    static int warmup(const IndicatorKey& key);
+    
+public:
+    IndicatorRegistry();
+    
+    // Get (computing if needed) a series over the given close prices.
+    // Returns an empty series for unknown names or bad parameters, with
+    // the reason in message (nothing is printed, so it's safe to call
+    // from worker threads). References stay valid until clear() is called.
+    const Series& get(const string& name, const vector<double>& params, const Series& closes, string& message);
+    
+    bool has(const string& name, const vector<double>& params) const;
+    
+    // Index of the first defined value of a cached series (0 if not
+    // cached). Values before it are 0 placeholders; a 0 from then on is
+    // a real value.
+    int firstValid(const string& name, const vector<double>& params) const;
+    int size() const;
+    
+    // Drop every cached series (call when the price data changes).
+    // Not safe while other threads still hold references from get().
+    void clear();
+    
+    // Extend every cached series to closes.size() (call after appending
+    // bars). References from get() stay valid but a series' data() may
+    // move. Not safe while other threads use the registry.
+    void extend(const Series& closes);
+    
+    // Drop the first `count` values of every series (the oldest bars were
+    // dropped). The rolling state keeps working as long as at least
+    // lookback() bars remain.
+    void eraseFront(int count);
+    
+    // Bars of history the cached series need to be extended correctly
+    int lookback() const;
+};
+
+#endif
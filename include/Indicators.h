@@ -0,0 +1,95 @@
+// Indicators.h
+#ifndef INDICATORS_H
+#define INDICATORS_H
+
+#include "AlignedVector.h"
+
+using namespace std;
+
+// Sum of the last `period` values, updated in O(1) per step.
+// The sum is recomputed from scratch every resumInterval steps so that
+// rounding errors from the add/subtract updates can't build up.
+struct RollingSum {
+    int period;
+    int resumInterval;
+    int steps;
+    double sum;
+    
+    RollingSum(int windowPeriod);
+    
+    // values[i] enters the window (values[i - period] leaves it)
+    void add(const double* values, int i);
+};
+
+// Sum of squared deviations from the window mean (sliding Welford update).
+// Uses the rolling means so the SMA series can be shared.
+struct RollingVariance {
+    int period;
+    int resumInterval;
+    int steps;
+    double m2;
+    
+    RollingVariance(int windowPeriod);
+    
+    // values[i] enters the window, means[i] is the mean of the new window
+    void add(const double* values, const double* means, int i);
+    double variance() const;
+};
+
+// Sum of co-deviations of two series from their window means, updated
+// the same way as RollingVariance
+struct RollingCovariance {
+    int period;
+    int resumInterval;
+    int steps;
+    double c2;
+    
+    RollingCovariance(int windowPeriod);
+    
+    // x[i], y[i] enter the window; meansX[i], meansY[i] are the new window means
+    void add(const double* x, const double* y, const double* meansX, const double* meansY, int i);
+    double covariance() const;
+};
+
+// Rolling sums of gains and losses for RSI, driven by the close prices.
+// The number of losing days is tracked exactly so a window without any
+// loss still gives RSI = 100 after many updates.
+struct RollingRSI {
+    int period;
+    int resumInterval;
+    int steps;
+    double sumGain;
+    double sumLoss;
+    int lossCount;
+    
+    RollingRSI(int windowPeriod);
+    
+    // Price change closes[i] - closes[i - 1] enters the window (i >= 1)
+    void add(const double* closes, int i);
+    double value() const;
+};
+
+// O(n) indicator kernels.
+// Outputs are resized to n and hold 0.0 until enough data is available.
+class Indicators {
+public:
+    static void sma(const double* values, int n, int period, Series& out);
+    static void ema(const double* values, int n, int period, Series& out);
+    static void stdDev(const double* values, const double* means, int n, int period, Series& out);
+    static void rsi(const double* closes, int n, int period, Series& out);
+    static void momentum(const double* closes, int n, int period, Series& out);
+    
+    // Extend out from out.size() to n (bars were appended to the input).
+    // The rolling state must be the one left by the calls that built out,
+    // so the result matches a full recomputation and costs O(1) per bar.
+    static void extendSMA(const double* values, int n, RollingSum& window, Series& out);
+    static void extendEMA(const double* values, int n, int period, Series& out);
+    static void extendStdDev(const double* values, const double* means, int n, RollingVariance& window, Series& out);
+    static void extendRSI(const double* closes, int n, RollingRSI& window, Series& out);
+    static void extendMomentum(const double* closes, int n, int period, Series& out);
+    
+    // Re-summation interval used by the rolling kernels
+    static int resumInterval(int period);
+};
+
+#endif
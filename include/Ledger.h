@@ -0,0 +1,69 @@
+// Ledger.h
+#ifndef LEDGER_H
+#define LEDGER_H
+
+#include <string>
+#include <vector>
+#include "SymbolTable.h"
+#include "ExecutionModel.h"
+
+using namespace std;
+
+// Trade history as parallel columns (structure of arrays), one row per
+// trade in the order they were made. Symbols are ids in
+// SymbolTable::global() (the same ids as holdings and stocks) and dates
+// are days since epoch; text is only produced by format().
+// Each symbol keeps the list of its rows, so per-symbol and date-range
+// queries don't scan the whole history.
+class Ledger {
+private:
+    vector<int> symbolIds;
+    vector<TradeSide> sides;
+    vector<int> quantities;
+    vector<double> prices;
+    vector<int> dates;
+    
+    vector<vector<int>> rowsBySymbol;   // Global symbol id -> its rows, ascending
+    bool datesSorted;                   // Rows were added in date order
+    
+    // Helper: rows of a list that fall in [fromDate, toDate]
+    void filterByDate(const vector<int>& rows, int fromDate, int toDate, vector<int>& out) const;
+    
+public:
+    Ledger();
+    
+    // Record a trade, returns its row
+    int add(const string& symbol, TradeSide side, int quantity, double price, int date);
+    
+    void reserve(size_t rows);
+    void clear();
+    int size() const { return symbolIds.size(); }
+    bool empty() const { return symbolIds.empty(); }
+    
+    // Single values
+    int getSymbolId(int row) const { return symbolIds[row]; }
+    const string& getSymbol(int row) const { return SymbolTable::global().name(symbolIds[row]); }
+    TradeSide getSide(int row) const { return sides[row]; }
+    int getQuantity(int row) const { return quantities[row]; }
+    double getPrice(int row) const { return prices[row]; }
+    int getDate(int row) const { return dates[row]; }
+    
+    // Symbol ids that have traded are below this
+    int symbolIdLimit() const { return rowsBySymbol.size(); }
+    
+    // Rows of one symbol (empty if it never traded), in trade order
+    const vector<int>& rowsForSymbol(const string& symbol) const;
+    const vector<int>& rowsForSymbol(int symbolId) const;
+    
+    // Rows with fromDate <= date <= toDate, optionally for one symbol only
+    // (empty symbol = all), in trade order
+    vector<int> query(const string& symbol, int fromDate, int toDate) const;
+    
+    // Same for one symbol id, into a reused buffer (empty for an unknown id)
+    void query(int symbolId, int fromDate, int toDate, vector<int>& out) const;
+    
+    // "BUY 10 AAPL @ $150.000000 on 2024-01-02"
+    string format(int row) const;
+};
+
+#endif
\ No newline at end of file
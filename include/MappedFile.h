@@ -0,0 +1,36 @@
+// MappedFile.h
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+using namespace std;
+
+// Read-only memory mapping of a whole file (RAII).
+// The mapping is released when the object goes out of scope.
+class MappedFile {
+private:
+    const char* data;
+    size_t length;
+    
+public:
+    MappedFile();
+    ~MappedFile();
+    
+    // Not copyable (owns the mapping)
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    // Map a file, returns false if it can't be opened or mapped
+    bool open(const string& filename);
+    void close();
+    
+    // Getters
+    const char* begin() const;
+    const char* end() const;
+    size_t size() const;
+    bool isOpen() const;
+};
+
+#endif
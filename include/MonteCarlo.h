@@ -0,0 +1,73 @@
+// MonteCarlo.h
+#ifndef MONTECARLO_H
+#define MONTECARLO_H
+
+#include <vector>
+#include <cstdint>
+#include "Stock.h"
+#include "ParameterSweep.h"
+#include "ExecutionModel.h"
+
+using namespace std;
+
+// Settings for a Monte Carlo run
+struct MonteCarloConfig {
+    int numPaths;
+    int pathLength;         // Returns per path (0 = as many as the history has)
+    int blockSize;          // Bootstrap block length in days (1 = plain resampling)
+    uint64_t seed;
+    double initialCash;
+    int numThreads;         // 0 = all cores
+    const ExecutionModel* execution;
+    
+    MonteCarloConfig();
+};
+
+// Outcome of the strategy on one simulated path
+struct MonteCarloPath {
+    double totalReturn;
+    double maxDrawdown;
+    double sharpeRatio;
+};
+
+// Mean and percentiles of one statistic over all paths
+struct Distribution {
+    double mean;
+    double p5;
+    double p50;
+    double p95;
+};
+
+struct MonteCarloResult {
+    vector<MonteCarloPath> paths;       // In path order
+    Distribution returns;
+    Distribution drawdowns;
+    Distribution sharpeRatios;
+    
+    // The strategy on the real history, for comparison
+    double historicalReturn;
+    double historicalDrawdown;
+    double historicalSharpe;
+};
+
+// Block-bootstrap Monte Carlo: builds synthetic price paths from blocks
+// of the stock's daily returns and backtests the strategy on each.
+// Path p only uses random numbers from stream p of a counter-based
+// generator, so results don't depend on the number of threads.
+class MonteCarlo {
+public:
+    static MonteCarloResult run(Stock* stock, StrategyFactory factory, const ParameterSet& params,
+                                const MonteCarloConfig& config);
+    
+    static void displayResults(const MonteCarloResult& result);
+    
+    // Counter-based random number: a pure function of (seed, stream,
+    // counter), so any draw can be made in any order on any thread
+    static uint64_t counterRandom(uint64_t seed, uint64_t stream, uint64_t counter);
+    
+private:
+    // Helper: mean and 5/50/95th percentiles
+    static Distribution summarize(vector<double> values);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,72 @@
+// ParameterSweep.h
+#ifndef PARAMETERSWEEP_H
+#define PARAMETERSWEEP_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include "Stock.h"
+#include "Strategy.h"
+#include "ExecutionModel.h"
+
+using namespace std;
+
+// Named parameter values for one strategy instance, e.g. {"period": 14}
+typedef map<string, double> ParameterSet;
+
+// Builds a fresh strategy for a parameter set (called from worker threads).
+// Returning nullptr skips that combination.
+typedef function<Strategy*(const ParameterSet&)> StrategyFactory;
+
+// Cartesian product of parameter values
+class ParameterGrid {
+private:
+    vector<string> names;
+    vector<vector<double>> values;
+    
+public:
+    // Add a parameter with explicit values or an inclusive range
+    void add(const string& name, const vector<double>& paramValues);
+    void addRange(const string& name, double from, double to, double step);
+    
+    // Number of combinations
+    long long size() const;
+    
+    // Combination number index (0 <= index < size())
+    ParameterSet at(long long index) const;
+};
+
+// Outcome of one backtest in a sweep
+struct SweepResult {
+    ParameterSet params;
+    double totalReturn;
+    double finalValue;
+    double maxDrawdown;
+    int numTrades;
+    int winningTrades;
+    bool valid;
+};
+
+// Runs one backtest per grid point on a work-stealing thread pool.
+// All backtests share the (read-only) Stock; each gets its own Strategy.
+class ParameterSweep {
+public:
+    // Results ranked by total return, best first. 0 threads = all cores.
+    // An execution model (shared, read-only) adds trading costs.
+    static vector<SweepResult> run(Stock* stock, const ParameterGrid& grid, StrategyFactory factory,
+                                   double initialCash = 10000.0, int numThreads = 0,
+                                   const ExecutionModel* execution = nullptr);
+    
+    // Print the best results
+    static void displayResults(const vector<SweepResult>& results, int top = 10);
+    
+    // Factories for the built-in strategies
+    // RSI: "period", "oversold", "overbought"; MA: "fast", "slow".
+    // A set missing one of these, or with a period that isn't a whole
+    // number >= 1, gives nullptr (combination skipped).
+    static StrategyFactory rsiFactory();
+    static StrategyFactory maFactory();
+};
+
+#endif
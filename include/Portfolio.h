@@ -3,52 +3,110 @@
 #define PORTFOLIO_H
 
 #include <string>
-#include <map>
 #include <vector>
+#include <cstdint>
 #include "Stock.h"
+#include "StockRegistry.h"
+#include "TransactionJournal.h"
+#include "Ledger.h"
 
 using namespace std;
 
 // Represents a single holding (one stock in portfolio)
 struct Holding {
     string symbol;
+    int symbolId;          // In SymbolTable::global()
     int quantity;
     double avgCost;        // Average purchase price
     string purchaseDate;   // When first bought
 };
 
+// On-disk header of a portfolio snapshot (64 bytes), followed by the
+// name, the holdings and the ledger (symbol names, then one array per column)
+struct PortfolioSnapshotHeader {
+    char magic[8];          // "QLPORT01"
+    uint32_t version;
+    uint32_t numHoldings;
+    uint64_t generation;    // Bumped on every save; the journal must match
+    uint64_t numTransactions;
+    uint64_t payloadBytes;
+    uint32_t checksum;      // Of the payload
+    uint32_t reserved;
+    double cashBalance;
+    double realizedPnL;
+};
+
 class Portfolio {
 private:
     string name;
-    map<string, Holding> holdings;  // symbol -> Holding
-    vector<string> transactions;     // History of all buys/sells
+    vector<Holding> holdings;        // Open positions, in no particular order
+    vector<int> holdingSlots;        // Symbol id -> index in holdings (-1 = none)
+    Ledger ledger;                   // History of all buys/sells
     double cashBalance;
+    double realizedPnL;              // Sale proceeds minus average cost of the shares sold
+    
+    // Persistence: the last snapshot plus a journal of later changes
+    string snapshotFile;             // Empty until saved or loaded
+    uint64_t generation;
+    TransactionJournal journal;
+    
+    // Helpers: index of a symbol's holding (-1 if none), rebuild the index
+    int findHolding(const string& symbol) const;
+    void indexHoldings();
+    
+    // Helper: holdings indices in symbol order, for display
+    vector<int> holdingsBySymbol() const;
+    
+    // Helpers: apply a change without checks or output (also used for replay)
+    void applyCash(double amount);
+    void applyBuy(const string& symbol, int quantity, double price, int date);
+    void applySell(const string& symbol, int quantity, double price, int date);
+    
+    // Helper: append a change to the journal (if the portfolio is saved)
+    void logChange(JournalType type, const string& symbol, int quantity, double amount, int date);
     
 public:
     // Constructor
-    Portfolio(string portfolioName);
+    Portfolio(const string& portfolioName);
     
     // Buy/Sell operations
-    void buyStock(string symbol, int quantity, double price, string date);
-    void sellStock(string symbol, int quantity, double price, string date);
+    void buyStock(const string& symbol, int quantity, double price, const string& date);
+    void sellStock(const string& symbol, int quantity, double price, const string& date);
     
     // Portfolio info
-    string getName() const;
+    const string& getName() const;
     double getCashBalance() const;
     void addCash(double amount);
     
     // Display functions
     void displayHoldings() const;
     void displayTransactions() const;
-    void displaySummary(const map<string, Stock*>& stockData) const;
+    
+    // Trades of one symbol (empty = all) between two dates (days since epoch)
+    void displayTransactions(const string& symbol, int fromDate, int toDate) const;
+    void displaySummary(const StockRegistry& stockData) const;
     
     // Check if portfolio has a stock
-    bool hasStock(string symbol) const;
-    int getQuantity(string symbol) const;
+    bool hasStock(const string& symbol) const;
+    int getQuantity(const string& symbol) const;
+    
+    // Trade history, for P&L and tax-lot reports
+    const Ledger& getLedger() const;
+    
+    // For valuation
+    const vector<Holding>& getHoldings() const;
+    double getRealizedPnL() const;
+    
+    // Save/Load portfolio to file.
+    // Saving writes a snapshot and starts a new journal (<file>.qlj); from
+    // then on every change is appended to the journal. Loading reads the
+    // snapshot and replays the journal. The portfolio keeps the journal
+    // locked, so both fail while another portfolio is using the file.
+    bool saveToFile(const string& filename);
+    bool loadFromFile(const string& filename);
     
-    // Save/Load portfolio to file
-    bool saveToFile(string filename) const;
-    bool loadFromFile(string filename);
+    // Flush journaled changes to disk
+    void sync();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,69 @@
+// PortfolioBacktester.h
+#ifndef PORTFOLIOBACKTESTER_H
+#define PORTFOLIOBACKTESTER_H
+
+#include "Stock.h"
+#include "Strategy.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+// Multi-asset backtest over a shared date index.
+// Each symbol's signals (from one strategy) switch it in or out of the
+// portfolio; capital is split equally across active symbols. A symbol
+// only trades on days it has a bar, and is sold off on its last bar.
+class PortfolioBacktester {
+private:
+    vector<Stock*> stocks;
+    Strategy* strategy;
+    double startingCash;
+    int rebalanceDays;     // Also rebalance every N days (0 = only on signal changes)
+    double maxWeight;      // Cap on one symbol's share of the portfolio
+    
+    // Aligned data, row-major [day][symbol] so a day is one contiguous row
+    vector<int> timeline;         // Union of all dates (days since epoch)
+    vector<double> prices;        // Last known close (0 before the first bar)
+    vector<int8_t> signals;       // SignalFlags, HOLD on days without a bar
+    vector<int8_t> hasBar;        // 1 where the symbol has a bar (tradable that day)
+    vector<int> lastDays;         // Day index of each symbol's last bar (-1 if none)
+    
+    // Results
+    vector<double> equityCurve;
+    vector<int> finalShares;
+    double cash;
+    double finalValue;
+    double totalReturn;
+    double maxDrawdown;
+    int numTrades;
+    double turnover;              // Traded value / average portfolio value
+    
+    // Helper: build timeline, price and signal matrices
+    void align();
+    
+    // Helper: move holdings to equal weights across active symbols
+    // (symbols without a bar that day keep their shares)
+    void rebalance(const double* dayPrices, const int8_t* tradable, const vector<bool>& active,
+                   vector<int>& shares, double portfolioValue, double& tradedValue);
+    
+public:
+    PortfolioBacktester(const vector<Stock*>& universe, Strategy* strat, double initialCash = 100000.0,
+                        int rebalanceEvery = 0, double maxPositionWeight = 1.0);
+    
+    // Run the backtest (verbose = print progress messages)
+    void run(bool verbose = true);
+    
+    // Display results
+    void displayResults() const;
+    
+    // Getters
+    double getTotalReturn() const;
+    double getFinalValue() const;
+    double getMaxDrawdown() const;
+    int getNumTrades() const;
+    const vector<double>& getEquityCurve() const;
+    const vector<int>& getTimeline() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,50 @@
+// PriceCache.h
+#ifndef PRICECACHE_H
+#define PRICECACHE_H
+
+#include <string>
+#include <cstdint>
+#include "BarStore.h"
+
+using namespace std;
+
+// On-disk header of a binary price cache (64 bytes).
+// Followed by contiguous columns: dates (int32, days since epoch, padded
+// to 8 bytes), open, high, low, close (double) and volume (int64).
+struct PriceCacheHeader {
+    char magic[8];          // "QLCACHE1"
+    uint32_t version;
+    uint32_t reserved;
+    int64_t sourceSize;     // Size of the CSV the cache was built from
+    int64_t sourceMtime;    // Modification time of that CSV (nanoseconds)
+    uint64_t rows;
+    char padding[24];
+};
+
+// Binary columnar cache sitting next to a CSV file (<file>.qlc).
+// The cache is only used while the CSV's size and mtime still match.
+class PriceCache {
+public:
+    static string cachePath(const string& csvFile);
+    
+    // Append cached bars, returns false if the cache is missing or stale
+    static bool load(const string& csvFile, BarStore& bars);
+    
+    // Write the cache for a CSV, returns false if it couldn't be written
+    static bool save(const string& csvFile, const BarStore& bars);
+    
+    // Check magic, version and that the file size matches the row count
+    static bool validHeader(const PriceCacheHeader& header, uint64_t fileBytes);
+    
+    // Byte offset of a column (0 = dates ... 5 = volumes) in a cache file
+    static size_t columnOffset(int column, uint64_t rows);
+    
+private:
+    // Helper: size/mtime of the source CSV
+    static bool sourceInfo(const string& csvFile, int64_t& size, int64_t& mtime);
+    
+    // Helper: expected file size for a number of rows
+    static size_t fileSize(uint64_t rows);
+};
+
+#endif
@@ -0,0 +1,63 @@
+// RollingAnalytics.h
+#ifndef ROLLINGANALYTICS_H
+#define ROLLINGANALYTICS_H
+
+#include <vector>
+#include <string>
+#include "Stock.h"
+
+using namespace std;
+
+// Rolling risk series for one stock, one value per bar.
+// Values are 0.0 until the window holds enough returns.
+struct RollingMetrics {
+    string symbol;
+    Series returns;         // % return into each day (0 on the first day)
+    Series volatility;      // Annualized, over the last `window` returns
+    Series sharpeRatio;
+    Series beta;            // Against the benchmark (empty without one)
+    Series drawdown;        // % below the highest close of the last `window` days
+};
+
+// O(n) rolling versions of the Analytics metrics. Each value uses the
+// same formula as the whole-history metric applied to its window.
+class RollingAnalytics {
+public:
+    // Metrics for one stock. Beta needs a benchmark; its closes are matched
+    // to the stock's dates (last benchmark close on or before each date),
+    // and beta stays 0 until `window` returns after the benchmark's first bar.
+    static RollingMetrics compute(const Stock* stock, int window, const Stock* benchmark = nullptr,
+                                  double riskFreeRate = 0.02);
+    
+    // Same for many stocks at once, in parallel (result order = input order)
+    static vector<RollingMetrics> computeBatch(const vector<Stock*>& stocks, int window,
+                                               const Stock* benchmark = nullptr,
+                                               double riskFreeRate = 0.02, int numThreads = 0);
+    
+    // Show the last numDays values
+    static void displayResults(const RollingMetrics& metrics, const Stock* stock, int numDays);
+    
+    // Latest values of every stock in a batch
+    static void displaySummary(const vector<RollingMetrics>& batch);
+    
+    // Kernels over raw arrays; out[i] covers values[i - window + 1 .. i]
+    static void mean(const double* values, int n, int window, double* out);
+    static void volatility(const double* returns, const double* means, int n, int window, double* out);
+    static void sharpeRatio(const double* means, const double* volatility, int n, double riskFreeRate, double* out);
+    static void beta(const double* returns, const double* marketReturns, const double* means,
+                     const double* marketMeans, int n, int window, double* out);
+    
+    // Drawdown from the highest price of the last `window` days
+    // (window <= 0: the highest price so far)
+    static void drawdown(const double* prices, int n, int window, double* out);
+    
+private:
+    // Helper: daily % returns aligned with the prices (out[0] = 0)
+    static void dailyReturns(const double* prices, int n, double* out);
+    
+    // Helper: benchmark closes on the stock's dates; returns the first
+    // index with a benchmark bar on or before its date (n if none)
+    static int alignCloses(const BarStore& bars, const BarStore& benchmark, double* out);
+};
+
+#endif
\ No newline at end of file
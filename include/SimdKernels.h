@@ -0,0 +1,44 @@
+// SimdKernels.h
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+using namespace std;
+
+// Vectorized kernels for the Analytics hot loops.
+// An AVX2 (x86-64) or NEON (AArch64) version is picked at runtime from
+// the CPU's features, with a portable scalar version as fallback.
+class SimdKernels {
+public:
+    // Daily % returns: out[k] = (p[i] - p[i-1]) / p[i-1] * 100.
+    // Days with a zero previous price are skipped; returns the count written
+    // (out needs room for n - 1 values).
+    static int dailyReturns(const double* prices, int n, double* out);
+    
+    // Mean and population variance in a single pass
+    static void meanVariance(const double* data, int n, double& mean, double& variance);
+    
+    // Largest peak-to-trough decline in %, 0 if prices never fall
+    static double maxDrawdown(const double* prices, int n);
+    
+    // 4x8 block of a matrix product over n rows of two row-major matrices
+    // with the same row stride:
+    // out[r * outStride + c] += sum over k of a[k * stride + r] * b[k * stride + c]
+    static void crossProduct4x8(const double* a, const double* b, int n, int stride,
+                                double* out, int outStride);
+    
+    // Name of the kernel set in use ("AVX2", "NEON" or "scalar")
+    static const char* activeKernel();
+    
+    // Force the scalar kernels (for comparisons/benchmarks, see
+    // bench/simd_bench.cpp). Safe to call while kernels are running.
+    static void forceScalar(bool enabled);
+    
+    // Scalar versions, also used for the tails of vector loops
+    static int dailyReturnsScalar(const double* prices, int n, double* out);
+    static void meanVarianceScalar(const double* data, int n, double& mean, double& variance);
+    static double maxDrawdownScalar(const double* prices, int n);
+    static void crossProduct4x8Scalar(const double* a, const double* b, int n, int stride,
+                                      double* out, int outStride);
+};
+
+#endif
@@ -4,6 +4,9 @@
 
 #include <string>
 #include <vector>
+#include <atomic>
+#include "BarStore.h"
+#include "IndicatorRegistry.h"
 
 using namespace std;
 
@@ -13,41 +16,105 @@ private:
     string symbol;
     string name;
     
-    // Historical data
-    vector<string> dates;
-    vector<double> openPrices;
-    vector<double> highPrices;
-    vector<double> lowPrices;
-    vector<double> closePrices;
-    vector<long long> volumes;
-    
-    // Technical indicators
-    vector<double> sma20;  // 20-day Simple Moving Average
-    vector<double> sma50;  // 50-day Simple Moving Average
-    vector<double> rsi;    // 14-day Relative Strength Index
-    vector<double> ema12;  // 12-day Exponential Moving Average
-    vector<double> ema26;  // 26-day Exponential Moving Average
-    vector<double> macd;   // MACD Line
-    vector<double> macdSignal;  // MACD Signal Line
-    vector<double> macdHistogram;  // MACD Histogram
-    vector<double> bollingerUpper;  // Bollinger Upper Band
-    vector<double> bollingerMiddle; // Bollinger Middle Band
-    vector<double> bollingerLower;  // Bollinger Lower Band
-    vector<double> momentum;        // Price momentum (10-day)
+    // Historical data (aligned columns, dates as days since epoch)
+    BarStore bars;
+    
+    // Technical indicators, cached by (name, params)
+    mutable IndicatorRegistry indicators;
+    
+    // Indicators behind the fixed getters below
+    enum StandardIndicator {
+        SMA_20,             // 20-day Simple Moving Average
+        SMA_50,             // 50-day Simple Moving Average
+        RSI_14,             // 14-day Relative Strength Index
+        MACD_LINE,          // MACD Line (12/26)
+        MACD_SIGNAL_LINE,   // MACD Signal Line (9)
+        MACD_HISTOGRAM,     // MACD Histogram
+        BOLLINGER_UPPER,    // Bollinger Upper Band (20, 2)
+        BOLLINGER_MIDDLE,   // Bollinger Middle Band
+        BOLLINGER_LOWER,    // Bollinger Lower Band
+        MOMENTUM_10,        // Price momentum (10-day)
+        NUM_STANDARD_INDICATORS
+    };
+    
+    // Series for each standard indicator (owned by the registry).
+    // nullptr until first used, then filled in lazily.
+    mutable atomic<const Series*> standardSeries[NUM_STANDARD_INDICATORS];
+    
+    // Compute all indicators when data is loaded instead of on first use
+    static bool eagerIndicators;
+    
+    // Use <file>.qlc binary caches when loading CSVs
+    static bool useBinaryCache;
+    
+    // Changes whenever the bars do (load, append, trim). Drawn from one
+    // process-wide counter, so no two data versions of any stock share it.
+    unsigned long revision;
+    static atomic<unsigned long> nextRevision;
+    void bumpRevision();
+    
+    // Parse a CSV file into the price columns
+    bool parseCSV(const string& filename, string& message);
+    
+    // Drop cached indicators (price data changed)
+    void resetIndicators();
+    
+    // Helper: series for a standard indicator, computed on first use
+    static IndicatorKey standardKey(StandardIndicator which);
+    const Series* standard(StandardIndicator which) const;
+    void setStandard(StandardIndicator which, const Series& series);
+    
+    // Helper: value of a series at index, 0.0 if missing
+    static double valueAt(const Series* series, int index);
     
 public:
     // Constructor
     Stock(string sym, string stockName);
     
+    // Not copyable (cached indicator pointers refer to our own registry)
+    Stock(const Stock&) = delete;
+    Stock& operator=(const Stock&) = delete;
+    
     // Load data from CSV
     bool loadFromCSV(string filename);
     
+    // Same, but doesn't print: errors/warnings go to message
+    bool loadFromCSV(const string& filename, string& message);
+    
+    // Add one new bar (e.g. a live end-of-day or intraday bar).
+    // Cached indicators are updated in O(1) each instead of recomputed.
+    // Dates must not go backwards. Not safe while other threads read
+    // this stock; indicator data() pointers may move.
+    bool appendBar(int date, double open, double high, double low, double close, long long volume);
+    
+    // Same for a block of bars (e.g. a generated price path)
+    bool appendBars(const BarStore& block);
+    
+    // Drop the oldest `count` bars and the matching indicator values, to
+    // keep a bounded window of recent bars (streaming). Keep at least
+    // getIndicatorLookback() bars so appendBar() stays exact.
+    void trimFront(int count);
+    int getIndicatorLookback() const;
+    
+    // Enable/disable the binary price cache (enabled by default)
+    static void setUseBinaryCache(bool enabled);
+    
+    // Indicators are computed lazily on first access (thread-safe).
+    // Eager mode computes the standard set right after loading instead.
+    static void setEagerIndicators(bool enabled);
+    static bool isEagerIndicators();
+    
     // Getters
-    string getSymbol() const;
-    string getName() const;
+    const string& getSymbol() const;
+    const string& getName() const;
     int getDataSize() const;
+    unsigned long getRevision() const;
     double getClosePrice(int index) const;
     vector<double> getAllClosePrices() const;
+    string getDate(int index) const;
+    
+    // Raw columns for vectorized kernels
+    const BarStore& getBars() const;
     
     // Display functions
     void displaySummary() const;
@@ -62,6 +129,21 @@ public:
     void calculateMomentum(int period = 10);
     void calculateAllIndicators();
     
+    // Compute the standard indicators now, without printing
+    void precomputeIndicators();
+    
+    // Any cached indicator series, computed on first use.
+    // e.g. getIndicator("SMA", {35}) or getIndicator("BB_UPPER", {20, 2})
+    // See IndicatorRegistry.h for the supported names. Unknown names or
+    // bad parameters give an empty series.
+    const Series& getIndicator(const string& name, const vector<double>& params) const;
+    
+    // Same, with the reason for an empty series in message
+    const Series& getIndicator(const string& name, const vector<double>& params, string& message) const;
+    
+    // Index of its first defined value; earlier values are 0 placeholders
+    int getIndicatorFirstValid(const string& name, const vector<double>& params) const;
+    
     // Get indicator value at index
     double getSMA20(int index) const;
     double getSMA50(int index) const;
@@ -0,0 +1,36 @@
+// StockLoader.h
+#ifndef STOCKLOADER_H
+#define STOCKLOADER_H
+
+#include <string>
+#include <vector>
+#include "Stock.h"
+#include "StockRegistry.h"
+
+using namespace std;
+
+// Outcome of a bulk load
+struct LoadReport {
+    int loaded;
+    int failed;
+    vector<string> messages;   // Errors and warnings, one per file
+    double seconds;
+};
+
+// Loads every CSV in a directory in parallel.
+// Each file becomes a Stock named after the file (data/AAPL.csv -> AAPL).
+class StockLoader {
+public:
+    // Sorted list of *.csv files in a directory
+    static vector<string> findCSVFiles(const string& directory);
+    
+    static bool isDirectory(const string& path);
+    
+    // Parse files (and compute indicators in eager mode) on a worker pool,
+    // then add the stocks to the registry, replacing any with the same symbol.
+    // Progress is printed by the calling thread only; 0 threads = all cores.
+    static LoadReport loadDirectory(const string& directory, StockRegistry& stocks,
+                                    int numThreads = 0, bool showProgress = true);
+};
+
+#endif
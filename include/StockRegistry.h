@@ -0,0 +1,42 @@
+// StockRegistry.h
+#ifndef STOCKREGISTRY_H
+#define STOCKREGISTRY_H
+
+#include <string>
+#include <vector>
+#include "Stock.h"
+#include "SymbolTable.h"
+
+using namespace std;
+
+// The loaded stocks, indexed by global symbol id (SymbolTable::global()).
+// A lookup by ticker is one hash probe, a lookup by id is an array read.
+// The registry owns its stocks.
+class StockRegistry {
+private:
+    vector<Stock*> byId;        // Symbol id -> stock (nullptr = not loaded)
+    vector<Stock*> sorted;      // Loaded stocks in symbol order, for listings
+    
+public:
+    StockRegistry();
+    ~StockRegistry();
+    
+    StockRegistry(const StockRegistry&) = delete;
+    StockRegistry& operator=(const StockRegistry&) = delete;
+    
+    // Add a stock under its symbol, deleting any it replaces
+    void add(Stock* stock);
+    
+    // nullptr if not loaded
+    Stock* find(const string& symbol) const;
+    Stock* get(int id) const { return (id >= 0 && id < (int)byId.size()) ? byId[id] : nullptr; }
+    
+    // One past the largest symbol id that may be loaded
+    int idLimit() const { return byId.size(); }
+    
+    int size() const { return sorted.size(); }
+    bool empty() const { return sorted.empty(); }
+    const vector<Stock*>& getStocks() const { return sorted; }
+};
+
+#endif
\ No newline at end of file
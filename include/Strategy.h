@@ -4,14 +4,28 @@
 
 #include "Stock.h"
 #include <string>
+#include <vector>
+#include <cstdint>
 
 using namespace std;
 
+// Per-day trading signal flags (a day may carry both)
+enum SignalFlags : int8_t {
+    SIGNAL_HOLD = 0,
+    SIGNAL_BUY = 1,    // Buy if not holding
+    SIGNAL_SELL = 2    // Sell if holding
+};
+
 // Base class for all trading strategies
 class Strategy {
 protected:
     string name;
     
+private:
+    // Last generated signals, reused while the stock's data revision is unchanged
+    vector<int8_t> cachedSignals;
+    unsigned long signalsRevision;
+    
 public:
     Strategy(string strategyName);
     virtual ~Strategy() {}
@@ -22,26 +36,62 @@ public:
     // Check if should sell on this day
     virtual bool shouldSell(Stock* stock, int day, bool currentlyHolding) = 0;
     
+    // Called before a backtest so indicator series can be looked up once
+    virtual void prepare(const Stock* /*stock*/) {}
+    
+    // Signals for every day in one pass (SignalFlags per day).
+    // The default asks shouldBuy/shouldSell for each day; strategies
+    // override it with a loop over their indicator columns.
+    virtual void generateSignals(Stock* stock, vector<int8_t>& signals);
+    
+    // generateSignals() with caching, so repeated runs on the same
+    // stock reuse the array (regenerated after a reload or new bars)
+    const vector<int8_t>& getSignals(Stock* stock);
+    
     string getName() const;
 };
 
-// RSI Strategy: Buy when RSI < 30, Sell when RSI > 70
+// RSI Strategy: Buy when RSI < 30, Sell when RSI > 70 (levels and period configurable)
 class RSIStrategy : public Strategy { 
+private:
+    int period;
+    double oversold;
+    double overbought;
+    
+    // RSI series of the stock being traded, valid while its revision is unchanged
+    unsigned long preparedRevision;
+    const Series* rsiValues;
+    
+    double rsiAt(const Stock* stock, int day);
+    
 public:
-    RSIStrategy();
+    RSIStrategy(int rsiPeriod = 14, double oversoldLevel = 30, double overboughtLevel = 70);
     bool shouldBuy(Stock* stock, int day, bool currentlyHolding) override;
     bool shouldSell(Stock* stock, int day, bool currentlyHolding) override;
+    void prepare(const Stock* stock) override;
+    void generateSignals(Stock* stock, vector<int8_t>& signals) override;
 };
 
 // Moving Average Crossover: Buy when SMA20 > SMA50, Sell when SMA20 < SMA50
+// (both periods configurable)
 class MAStrategy : public Strategy {
 private:
-    bool previousCrossAbove;
+    int fastPeriod;
+    int slowPeriod;
+    
+    // SMA series of the stock being traded, valid while its revision is unchanged
+    unsigned long preparedRevision;
+    const Series* fastValues;
+    const Series* slowValues;
+    
+    void ensurePrepared(const Stock* stock);
     
 public:
-    MAStrategy();
+    MAStrategy(int fast = 20, int slow = 50);
     bool shouldBuy(Stock* stock, int day, bool currentlyHolding) override;
     bool shouldSell(Stock* stock, int day, bool currentlyHolding) override;
+    void prepare(const Stock* stock) override;
+    void generateSignals(Stock* stock, vector<int8_t>& signals) override;
 };
 
 // Buy and Hold: Buy on first day, never sell
@@ -50,6 +100,7 @@ public:
     BuyHoldStrategy();
     bool shouldBuy(Stock* stock, int day, bool currentlyHolding) override;
     bool shouldSell(Stock* stock, int day, bool currentlyHolding) override;
+    void generateSignals(Stock* stock, vector<int8_t>& signals) override;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,231 @@
+// StrategyDSL.h
+#ifndef STRATEGYDSL_H
+#define STRATEGYDSL_H
+
+#include "Strategy.h"
+#include <string>
+#include <tuple>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+// Compile-time strategy rules, e.g.
+//   RuleStrategy<And<RSIBelow<30>, PriceAbove<SMA<50>>>, RSIAbove<70>>
+// Every rule is a small value type: bind() looks up its columns once,
+// operator()(day) is inline, so generateSignals() compiles to one loop
+// with no virtual calls or map lookups per bar.
+namespace dsl {
+
+// ===== Value sources =====
+// An indicator is ready from the end of its warm-up (taken from the
+// registry), so a real value of 0, e.g. flat momentum, still counts
+
+// Base for sources backed by an indicator column
+struct SeriesSource {
+    const double* values = nullptr;
+    int firstValid = 0;
+    
+    void bindSeries(const Stock* stock, const string& name, const vector<double>& params) {
+        values = stock->getIndicator(name, params).data();
+        firstValid = stock->getIndicatorFirstValid(name, params);
+    }
+    inline double operator[](int i) const { return values[i]; }
+    inline bool ready(int i) const { return i >= firstValid; }
+};
+
+// Closing price
+struct Close {
+    const double* values = nullptr;
+    
+    void bind(const Stock* stock) { values = stock->getBars().getCloses().data(); }
+    inline double operator[](int i) const { return values[i]; }
+    inline bool ready(int) const { return true; }
+};
+
+// Integer constant (thresholds)
+template <int N>
+struct Const {
+    void bind(const Stock*) {}
+    inline double operator[](int) const { return N; }
+    inline bool ready(int) const { return true; }
+};
+
+template <int N>
+struct SMA : SeriesSource {
+    void bind(const Stock* stock) { bindSeries(stock, "SMA", {(double)N}); }
+};
+
+template <int N>
+struct EMA : SeriesSource {
+    void bind(const Stock* stock) { bindSeries(stock, "EMA", {(double)N}); }
+};
+
+template <int N>
+struct RSI : SeriesSource {
+    void bind(const Stock* stock) { bindSeries(stock, "RSI", {(double)N}); }
+};
+
+template <int N>
+struct Momentum : SeriesSource {
+    void bind(const Stock* stock) { bindSeries(stock, "MOMENTUM", {(double)N}); }
+};
+
+// ===== Comparisons =====
+
+template <typename A, typename B>
+struct Below {
+    A a;
+    B b;
+    
+    void bind(const Stock* stock) { a.bind(stock); b.bind(stock); }
+    inline bool operator()(int i) const { return a.ready(i) && b.ready(i) && a[i] < b[i]; }
+};
+
+template <typename A, typename B>
+struct Above {
+    A a;
+    B b;
+    
+    void bind(const Stock* stock) { a.bind(stock); b.bind(stock); }
+    inline bool operator()(int i) const { return a.ready(i) && b.ready(i) && a[i] > b[i]; }
+};
+
+// A was at or below B yesterday and is above it today
+template <typename A, typename B>
+struct CrossAbove {
+    A a;
+    B b;
+    
+    void bind(const Stock* stock) { a.bind(stock); b.bind(stock); }
+    inline bool operator()(int i) const {
+        return i >= 1 && a.ready(i) && b.ready(i) && a.ready(i - 1) && b.ready(i - 1)
+            && a[i - 1] <= b[i - 1] && a[i] > b[i];
+    }
+};
+
+// A was at or above B yesterday and is below it today
+template <typename A, typename B>
+struct CrossBelow {
+    A a;
+    B b;
+    
+    void bind(const Stock* stock) { a.bind(stock); b.bind(stock); }
+    inline bool operator()(int i) const {
+        return i >= 1 && a.ready(i) && b.ready(i) && a.ready(i - 1) && b.ready(i - 1)
+            && a[i - 1] >= b[i - 1] && a[i] < b[i];
+    }
+};
+
+// ===== Combinators =====
+
+template <typename... Rules>
+struct And {
+    tuple<Rules...> rules;
+    
+    void bind(const Stock* stock) {
+        apply([stock](Rules&... rule) { (rule.bind(stock), ...); }, rules);
+    }
+    inline bool operator()(int i) const {
+        return apply([i](const Rules&... rule) { return (rule(i) && ...); }, rules);
+    }
+};
+
+template <typename... Rules>
+struct Or {
+    tuple<Rules...> rules;
+    
+    void bind(const Stock* stock) {
+        apply([stock](Rules&... rule) { (rule.bind(stock), ...); }, rules);
+    }
+    inline bool operator()(int i) const {
+        return apply([i](const Rules&... rule) { return (rule(i) || ...); }, rules);
+    }
+};
+
+template <typename Rule>
+struct Not {
+    Rule rule;
+    
+    void bind(const Stock* stock) { rule.bind(stock); }
+    inline bool operator()(int i) const { return !rule(i); }
+};
+
+// Never fires (e.g. a strategy that never sells)
+struct Never {
+    void bind(const Stock*) {}
+    inline bool operator()(int) const { return false; }
+};
+
+// ===== Shorthands =====
+
+template <int Threshold, int Period = 14>
+using RSIBelow = Below<RSI<Period>, Const<Threshold>>;
+
+template <int Threshold, int Period = 14>
+using RSIAbove = Above<RSI<Period>, Const<Threshold>>;
+
+template <typename Source>
+using PriceAbove = Above<Close, Source>;
+
+template <typename Source>
+using PriceBelow = Below<Close, Source>;
+
+}
+
+// Adapter from compile-time rules to the Strategy interface
+template <typename BuyRule, typename SellRule>
+class RuleStrategy : public Strategy {
+private:
+    BuyRule buyRule;
+    SellRule sellRule;
+    unsigned long preparedRevision;     // Stock revision the rules are bound to
+    
+    void ensurePrepared(const Stock* stock) {
+        if (stock->getRevision() != preparedRevision) {
+            prepare(stock);
+        }
+    }
+    
+public:
+    RuleStrategy(string strategyName = "Rule Strategy") : Strategy(strategyName) {
+        preparedRevision = 0;
+    }
+    
+    void prepare(const Stock* stock) override {
+        buyRule.bind(stock);
+        sellRule.bind(stock);
+        preparedRevision = stock->getRevision();
+    }
+    
+    bool shouldBuy(Stock* stock, int day, bool currentlyHolding) override {
+        if (currentlyHolding || day < 0 || day >= stock->getDataSize()) return false;
+        ensurePrepared(stock);
+        return buyRule(day);
+    }
+    
+    bool shouldSell(Stock* stock, int day, bool currentlyHolding) override {
+        if (!currentlyHolding || day < 0 || day >= stock->getDataSize()) return false;
+        ensurePrepared(stock);
+        return sellRule(day);
+    }
+    
+    // Both rules fused into one loop
+    void generateSignals(Stock* stock, vector<int8_t>& signals) override {
+        prepare(stock);
+        int dataSize = stock->getDataSize();
+        signals.assign(dataSize, SIGNAL_HOLD);
+        
+        int8_t* out = signals.data();
+        for (int day = 0; day < dataSize; day++) {
+            out[day] = (buyRule(day) ? SIGNAL_BUY : SIGNAL_HOLD) | (sellRule(day) ? SIGNAL_SELL : SIGNAL_HOLD);
+        }
+    }
+};
+
+// Ready-made rule strategies
+typedef RuleStrategy<dsl::RSIBelow<30>, dsl::RSIAbove<70>> RSIRuleStrategy;
+typedef RuleStrategy<dsl::CrossAbove<dsl::SMA<20>, dsl::SMA<50>>, dsl::CrossBelow<dsl::SMA<20>, dsl::SMA<50>>> MACrossRuleStrategy;
+typedef RuleStrategy<dsl::And<dsl::RSIBelow<30>, dsl::PriceAbove<dsl::SMA<50>>>, dsl::RSIAbove<70>> RSITrendRuleStrategy;
+
+#endif
\ No newline at end of file
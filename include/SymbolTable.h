@@ -0,0 +1,45 @@
+// SymbolTable.h
+#ifndef SYMBOLTABLE_H
+#define SYMBOLTABLE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+// Interns ticker symbols as small dense ids (0, 1, 2, ...), so records
+// can store an int instead of a string and ids can index flat arrays.
+// Lookups go through an open-addressing hash table (linear probing) of
+// ids, so a probe reads one flat array instead of chasing list nodes.
+class SymbolTable {
+private:
+    vector<string> names;       // Id -> symbol
+    vector<size_t> hashes;      // Id -> hash of its symbol
+    vector<int> slots;          // Hash table of ids, -1 = empty; size is a power of 2
+    
+    // Helper: slot holding the symbol, or the empty slot where it belongs
+    size_t probe(const string& symbol, size_t hash) const;
+    
+    // Helper: rebuild the slots at twice the size
+    void grow();
+    
+public:
+    SymbolTable();
+    
+    // Id of a symbol, adding it if new
+    int intern(const string& symbol);
+    
+    // Id of a symbol, or -1 if it was never interned
+    int find(const string& symbol) const;
+    
+    const string& name(int id) const { return names[id]; }
+    int size() const { return names.size(); }
+    void clear();
+    
+    // Process-wide table, so stocks, holdings and ledgers of the same
+    // ticker share one id. Intern from the main thread only; never cleared.
+    static SymbolTable& global();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+// TaxLotEngine.h
+#ifndef TAXLOTENGINE_H
+#define TAXLOTENGINE_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include "Ledger.h"
+
+using namespace std;
+
+// Which lots a sell relieves
+enum LotMethod {
+    LOT_FIFO,       // Oldest first
+    LOT_LIFO,       // Newest first
+    LOT_SPECIFIC    // Lots chosen per sell (unchosen sells fall back to FIFO)
+};
+
+const char* lotMethodName(LotMethod method);
+
+// Shares still open from one buy, identified by the buy's ledger row.
+// Replacement shares of a wash sale are split off into a lot of their
+// own (same row), so only they carry the deferred loss and the washed
+// lot's holding period.
+struct TaxLot {
+    int row;
+    int date;               // Start of the holding period (moved back for replacements)
+    int remaining;
+    double costPerShare;    // Including wash-sale adjustments
+    bool replacement;       // Already absorbed a wash-sale loss
+};
+
+// Replacement shares matched to one washed loss
+struct WashReplacement {
+    int shares;
+    double lossPerShare;    // Added to their cost
+    int heldDays;           // Holding period of the washed shares, added to theirs
+};
+
+// Shares of one lot closed by one sell
+struct RealizedGain {
+    int sellRow;
+    int lotRow;
+    int quantity;
+    int buyDate;
+    int sellDate;
+    double costBasis;
+    double proceeds;
+    double gain;            // Proceeds - cost basis
+    double disallowed;      // Loss deferred by the wash-sale rule (>= 0)
+    bool longTerm;          // Held more than a year
+};
+
+// Replays a ledger lot by lot. Each symbol keeps its open lots in buy
+// order in a deque, so FIFO and LIFO sells pop from either end in
+// amortized O(1) and specific lots are found by binary search on the row
+// (emptied lots in the middle are skipped until they reach an end).
+// A loss is a wash sale when other shares of the symbol are bought
+// within 30 days before or after the sale; the disallowed loss is added
+// to the cost of those replacement shares, and the time the washed
+// shares were held is added to their holding period.
+class TaxLotEngine {
+private:
+    LotMethod method;
+    const Ledger* ledger;
+    
+    vector<deque<TaxLot>> lots;         // Global symbol id -> open lots, in buy order
+    vector<RealizedGain> gains;         // In sell order
+    
+    // Wash sales against buys not yet replayed
+    vector<int> replacementUsed;        // Per ledger row: shares already used as a replacement
+    multimap<int, WashReplacement> pending;   // Buy row -> replacement shares to split off
+    
+    // Helpers
+    TaxLot* findLot(int symbolId, int row);
+    deque<TaxLot>::iterator findPlainLot(int symbolId, int row);
+    void openLots(int row);
+    void splitReplacement(int symbolId, deque<TaxLot>::iterator plain, const WashReplacement& wash);
+    void trimEmpty(deque<TaxLot>& open);
+    int closeShares(TaxLot& lot, int sellRow, int quantity);
+    void applyWashSales(int sellRow, int firstGain, vector<int>& window);
+    
+public:
+    TaxLotEngine(LotMethod reliefMethod);
+    
+    // Rebuild lots and realized gains from a ledger. For LOT_SPECIFIC,
+    // lotChoices maps a sell row to the buy row to relieve first.
+    void rebuild(const Ledger& history, const map<int, int>& lotChoices = map<int, int>());
+    
+    const vector<RealizedGain>& getGains() const { return gains; }
+    
+    // Open lots of one symbol (empty if none)
+    vector<TaxLot> getOpenLots(const string& symbol) const;
+    
+    // Totals of reportable gains (gain + disallowed)
+    double getShortTermGain() const;
+    double getLongTermGain() const;
+    double getDisallowedLoss() const;
+    
+    void displayOpenLots() const;
+    void displayRealizedGains() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,63 @@
+// ThreadPool.h
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+
+using namespace std;
+
+// Fixed-size work-stealing thread pool.
+// Each worker has its own deque: it runs its newest task first and, when
+// empty, steals the oldest task of another worker. Tasks submitted from
+// inside a task go to the submitting worker's deque.
+class ThreadPool {
+private:
+    struct WorkerQueue {
+        deque<function<void()>> tasks;
+        mutex lock;
+    };
+    
+    vector<thread> workers;
+    vector<unique_ptr<WorkerQueue>> queues;
+    
+    atomic<int> queued;        // Tasks waiting in any deque
+    atomic<unsigned> nextQueue; // Round-robin target for outside submits
+    
+    // Sleeping/waking workers and waitAll()
+    mutex stateMutex;
+    condition_variable taskAvailable;
+    condition_variable allDone;
+    int pending;               // Tasks queued or running
+    bool stopping;
+    
+    void workerLoop(int index);
+    bool popTask(int index, function<void()>& task);
+    
+public:
+    // 0 threads = one per hardware thread
+    ThreadPool(int numThreads = 0);
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    // Queue a task
+    void submit(function<void()> task);
+    
+    // Block until every submitted task has finished
+    void waitAll();
+    
+    int size() const;
+    
+    // Number of hardware threads (at least 1)
+    static int defaultThreads();
+};
+
+#endif
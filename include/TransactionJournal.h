@@ -0,0 +1,98 @@
+// TransactionJournal.h
+#ifndef TRANSACTIONJOURNAL_H
+#define TRANSACTIONJOURNAL_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+// Kinds of journaled portfolio changes
+enum JournalType : uint8_t {
+    JOURNAL_CASH = 1,
+    JOURNAL_BUY = 2,
+    JOURNAL_SELL = 3
+};
+
+// One portfolio change, as replayed on load
+struct JournalRecord {
+    JournalType type;
+    string symbol;          // Empty for cash
+    int quantity;
+    double amount;          // Price per share, or the cash amount
+    int date;               // Days since epoch (0 for cash)
+};
+
+// On-disk header of a journal file (32 bytes)
+struct JournalHeader {
+    char magic[8];          // "QLJRNL01"
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t generation;    // Snapshot generation the journal continues
+    char padding[8];
+};
+
+// Append-only log of portfolio changes written next to a snapshot
+// (<file>.qlj). Each record is one write() of a length- and
+// checksum-prefixed entry; fsync is batched every JOURNAL_SYNC_RECORDS
+// records and on sync()/close(). A torn record at the end (crash during
+// a write) fails its checksum and is cut off on the next open.
+// The file is held with an exclusive flock() from lock() until close(),
+// so two portfolios (or processes) can't append to the same journal.
+class TransactionJournal {
+private:
+    int fd;
+    int unsyncedRecords;
+    string path;
+    
+public:
+    static const int JOURNAL_SYNC_RECORDS = 32;
+    
+    TransactionJournal();
+    ~TransactionJournal();
+    
+    // Not copyable (owns the file descriptor)
+    TransactionJournal(const TransactionJournal&) = delete;
+    TransactionJournal& operator=(const TransactionJournal&) = delete;
+    
+    static string journalPath(const string& snapshotFile);
+    
+    // Open (creating if needed) and exclusively lock a journal file without
+    // changing it. Returns false with errno == EWOULDBLOCK if another
+    // journal object holds the lock.
+    bool lock(const string& filename);
+    
+    // Start an empty journal for a snapshot generation (replaces any old
+    // one). Needs lock().
+    bool create(uint64_t generation);
+    
+    // Read the locked journal's records and append after them. Returns
+    // false (keeping the lock) if it's empty, foreign or from another
+    // generation.
+    bool open(uint64_t generation, vector<JournalRecord>& records);
+    
+    // Log one change (one write, fsync every JOURNAL_SYNC_RECORDS records)
+    bool append(const JournalRecord& record);
+    
+    // Flush outstanding records to disk
+    bool sync();
+    void close();
+    bool isOpen() const;
+    const string& getPath() const { return path; }
+    
+    // Exchange files (and locks) with another journal
+    void swap(TransactionJournal& other);
+    
+    // FNV-1a checksum used for records (and portfolio snapshots)
+    static uint32_t checksum(const char* data, size_t length);
+    
+private:
+    // Helper: serialize a record, returns its size in bytes
+    static size_t encode(const JournalRecord& record, char* out);
+    
+    // Helper: parse one record, returns its size or 0 if torn/invalid
+    static size_t decode(const char* data, size_t available, JournalRecord& record);
+};
+
+#endif
\ No newline at end of file
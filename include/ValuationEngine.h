@@ -0,0 +1,70 @@
+// ValuationEngine.h
+#ifndef VALUATIONENGINE_H
+#define VALUATIONENGINE_H
+
+#include <vector>
+#include <string>
+#include "SymbolTable.h"
+#include "Stock.h"
+#include "StockRegistry.h"
+
+using namespace std;
+
+class Portfolio;
+
+// Value of one portfolio at the current prices
+struct Valuation {
+    double marketValue;     // Holdings at their latest close (at cost if unpriced)
+    double costBasis;
+    double unrealizedPnL;
+    double realizedPnL;
+    double cash;
+    double totalValue;      // Market value + cash
+    int unpricedHoldings;   // Holdings without a loaded price
+};
+
+// Marks portfolios to market from an array of latest closes indexed by
+// global symbol id. The holdings of all registered portfolios are flattened into
+// parallel position arrays (portfolio p owns positions
+// [offsets[p], offsets[p + 1])), so revaluing after new prices is one
+// pass over those arrays, however many portfolios there are.
+class ValuationEngine {
+private:
+    vector<double> prices;              // Global symbol id -> latest close (0 = unknown)
+    
+    vector<const Portfolio*> portfolios;
+    vector<int> offsets;
+    vector<int> positionSymbols;        // Symbol id of each position
+    vector<double> quantities;
+    vector<double> costBases;           // Quantity x average cost
+    vector<double> marketValues;        // Filled by revalue()
+    vector<Valuation> valuations;
+    
+public:
+    ValuationEngine();
+    
+    // Latest close of every loaded stock
+    void updatePrices(const StockRegistry& stocks);
+    
+    // One new price (e.g. after Stock::appendBar)
+    void updatePrice(const string& symbol, double close);
+    
+    // Register portfolios and flatten their holdings (call again after trades)
+    void setPortfolios(const vector<Portfolio*>& list);
+    
+    // Mark every position to market and total each portfolio
+    void revalue();
+    
+    // Results (after revalue)
+    int getNumPortfolios() const { return portfolios.size(); }
+    const Valuation& getValuation(int portfolio) const { return valuations[portfolio]; }
+    
+    // Position k of a portfolio is its getHoldings()[k]
+    double getPrice(int portfolio, int k) const;
+    double getMarketValue(int portfolio, int k) const;
+    
+    // Table of all registered portfolios
+    void displayValuations() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,57 @@
+// WalkForward.h
+#ifndef WALKFORWARD_H
+#define WALKFORWARD_H
+
+#include <vector>
+#include "Stock.h"
+#include "ParameterSweep.h"
+#include "ExecutionModel.h"
+
+using namespace std;
+
+// One train/test split. Days are indices into the stock, end exclusive.
+struct WalkForwardWindow {
+    int trainStart;
+    int trainEnd;
+    int testStart;
+    int testEnd;
+    
+    ParameterSet bestParams;    // Best total return on the train days
+    double trainReturn;
+    double testReturn;          // Out-of-sample return with bestParams
+    int testTrades;
+    bool valid;                 // false if no combination could be run
+};
+
+// Stitched out-of-sample result
+struct WalkForwardResult {
+    vector<WalkForwardWindow> windows;
+    Series equityCurve;         // Value at each test day, capital carried across windows
+    int firstTestDay;           // Stock index of equityCurve[0]
+    double startingCash;
+    double finalValue;
+    double totalReturn;
+    double maxDrawdown;
+};
+
+// Walk-forward optimization: fit parameters on a rolling train window,
+// trade them on the following test window, then roll forward by the
+// test length. Windows are day ranges over the one Stock (no copies).
+class WalkForward {
+public:
+    // Every combination's signals are generated once over the whole
+    // history (indicators only look back) and backtested on every train
+    // window, combinations spread over a thread pool. 0 threads = all cores.
+    static WalkForwardResult run(Stock* stock, const ParameterGrid& grid, StrategyFactory factory,
+                                 int trainDays, int testDays, double initialCash = 10000.0,
+                                 int numThreads = 0, const ExecutionModel* execution = nullptr);
+    
+    // Print per-window choices and the stitched result
+    static void displayResults(const WalkForwardResult& result);
+    
+private:
+    // Helper: rolling windows over numDays days
+    static vector<WalkForwardWindow> makeWindows(int numDays, int trainDays, int testDays);
+};
+
+#endif
\ No newline at end of file
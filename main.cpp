@@ -2,11 +2,25 @@
 #include <iostream>
 #include <vector>
 #include <map>
+#include <cstdlib>
+#include <climits>
 #include "include/Stock.h"
+#include "include/DateUtil.h"
 #include "include/Portfolio.h"
+#include "include/ValuationEngine.h"
+#include "include/TaxLotEngine.h"
 #include "include/Analytics.h"
 #include "include/Strategy.h"
 #include "include/Backtester.h"
+#include "include/PortfolioBacktester.h"
+#include "include/StrategyDSL.h"
+#include "include/WalkForward.h"
+#include "include/MonteCarlo.h"
+#include "include/RollingAnalytics.h"
+#include "include/CovarianceEngine.h"
+#include "include/StockLoader.h"
+#include "include/StockRegistry.h"
+#include "include/ParameterSweep.h"
 
 using namespace std;
 
@@ -32,7 +46,8 @@ void displayPortfolioMenu() {
     cout << "1. Create new portfolio" << endl;
     cout << "2. View all portfolios" << endl;
     cout << "3. Select portfolio" << endl;
-    cout << "4. Back to main menu" << endl;
+    cout << "4. Load portfolio from file" << endl;
+    cout << "5. Back to main menu" << endl;
     cout << "======================================" << endl;
     cout << "Enter choice: ";
 }
@@ -47,17 +62,41 @@ void displaySelectedPortfolioMenu(string portfolioName) {
     cout << "4. View holdings" << endl;
     cout << "5. View transactions" << endl;
     cout << "6. View summary" << endl;
-    cout << "7. Back" << endl;
+    cout << "7. Save to file (later changes are journaled)" << endl;
+    cout << "8. Tax lots and realized gains" << endl;
+    cout << "9. Back" << endl;
     cout << "======================================" << endl;
     cout << "Enter choice: ";
 }
 
-int main() {
-    map<string, Stock*> stocks;           // symbol -> Stock object
+// Load every CSV in a directory and print a short report
+void loadStockDirectory(string directory, StockRegistry& stocks, int numThreads) {
+    cout << "\nLoading all CSV files in " << directory << "..." << endl;
+    
+    LoadReport report = StockLoader::loadDirectory(directory, stocks, numThreads);
+    
+    for (const string& message : report.messages) {
+        cout << "  " << message << endl;
+    }
+    cout << "✓ Loaded " << report.loaded << " stock(s)";
+    if (report.failed > 0) {
+        cout << ", " << report.failed << " failed";
+    }
+    cout << " in " << report.seconds << "s" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    StockRegistry stocks;                  // Loaded stocks, by symbol id
     vector<Portfolio*> portfolios;         // All portfolios
     
     cout << "\n*** Welcome to QuantLab ***\n" << endl;
     
+    // Optional: quantlab <data directory> [threads]
+    if (argc > 1) {
+        int numThreads = (argc > 2) ? atoi(argv[2]) : 0;
+        loadStockDirectory(argv[1], stocks, numThreads);
+    }
+    
     while (true) {
         displayMainMenu();
         int choice;
@@ -88,10 +127,11 @@ int main() {
                         cout << "\nNo portfolios yet. Create one first!" << endl;
                     } else {
                         cout << "\n=== Your Portfolios ===" << endl;
-                        for (int i = 0; i < portfolios.size(); i++) {
-                            cout << i + 1 << ". " << portfolios[i]->getName() 
-                                 << " (Cash: $" << portfolios[i]->getCashBalance() << ")" << endl;
-                        }
+                        ValuationEngine engine;
+                        engine.updatePrices(stocks);
+                        engine.setPortfolios(portfolios);
+                        engine.revalue();
+                        engine.displayValuations();
                     }
                     
                 } else if (portfolioChoice == 3) {
@@ -169,14 +209,72 @@ int main() {
                             currentPortfolio->displayHoldings();
                             
                         } else if (action == 5) {
-                            // View transactions
-                            currentPortfolio->displayTransactions();
+                            // View transactions (optionally one symbol / date range)
+                            string symbol, from, to;
+                            cout << "Filter by symbol (or ALL): ";
+                            cin >> symbol;
+                            cout << "From date (YYYY-MM-DD, or ALL): ";
+                            cin >> from;
+                            
+                            int fromDate = INT_MIN, toDate = INT_MAX;
+                            if (from != "ALL") {
+                                cout << "To date (YYYY-MM-DD): ";
+                                cin >> to;
+                                if (!DateUtil::parseDate(from, fromDate) || !DateUtil::parseDate(to, toDate)) {
+                                    cout << "Invalid date." << endl;
+                                    continue;
+                                }
+                            }
+                            
+                            if (symbol == "ALL" && from == "ALL") {
+                                currentPortfolio->displayTransactions();
+                            } else {
+                                currentPortfolio->displayTransactions(symbol == "ALL" ? "" : symbol, fromDate, toDate);
+                            }
                             
                         } else if (action == 6) {
                             // View summary
                             currentPortfolio->displaySummary(stocks);
                             
                         } else if (action == 7) {
+                            // Save snapshot
+                            string filename;
+                            cout << "Enter filename: ";
+                            cin >> filename;
+                            currentPortfolio->saveToFile(filename);
+                            
+                        } else if (action == 8) {
+                            // Tax lots: replay the ledger with a relief method
+                            char methodChoice;
+                            cout << "Relief method - FIFO, LIFO or specific lots? (f/l/s): ";
+                            cin >> methodChoice;
+                            
+                            LotMethod method = LOT_FIFO;
+                            if (methodChoice == 'l' || methodChoice == 'L') method = LOT_LIFO;
+                            if (methodChoice == 's' || methodChoice == 'S') method = LOT_SPECIFIC;
+                            
+                            // Specific lots: sell and buy numbers as shown in the transaction list
+                            map<int, int> lotChoices;
+                            if (method == LOT_SPECIFIC) {
+                                currentPortfolio->displayTransactions();
+                                cout << "For each sell, enter its number and the buy to relieve first (0 to finish)" << endl;
+                                while (true) {
+                                    int sellNumber, buyNumber;
+                                    cout << "Sell #: ";
+                                    cin >> sellNumber;
+                                    if (sellNumber <= 0) break;
+                                    cout << "Buy #: ";
+                                    cin >> buyNumber;
+                                    lotChoices[sellNumber - 1] = buyNumber - 1;
+                                }
+                            }
+                            
+                            TaxLotEngine engine(method);
+                            engine.rebuild(currentPortfolio->getLedger(), lotChoices);
+                            engine.displayOpenLots();
+                            engine.displayRealizedGains();
+                            
+                        } else if (action == 9) {
                             // Back
                             break;
                             
@@ -186,6 +284,19 @@ int main() {
                     }
                     
                 } else if (portfolioChoice == 4) {
+                    // Load portfolio
+                    string filename;
+                    cout << "\nEnter filename: ";
+                    cin >> filename;
+                    
+                    Portfolio* loaded = new Portfolio("");
+                    if (loaded->loadFromFile(filename)) {
+                        portfolios.push_back(loaded);
+                    } else {
+                        delete loaded;
+                    }
+                    
+                } else if (portfolioChoice == 5) {
                     // Back to main menu
                     break;
                     
@@ -198,18 +309,25 @@ int main() {
             // ===== LOAD STOCK DATA =====
             string symbol, name, filename;
             
-            cout << "\nEnter stock symbol: ";
+            cout << "\nEnter CSV filename or data directory: ";
+            cin.ignore();
+            getline(cin, filename);
+            
+            if (StockLoader::isDirectory(filename)) {
+                loadStockDirectory(filename, stocks, 0);
+                continue;
+            }
+            
+            cout << "Enter stock symbol: ";
             cin >> symbol;
             cout << "Enter company name: ";
             cin.ignore();
             getline(cin, name);
-            cout << "Enter CSV filename: ";
-            getline(cin, filename);
             
             Stock* newStock = new Stock(symbol, name);
             
             if (newStock->loadFromCSV(filename)) {
-                stocks[symbol] = newStock;
+                stocks.add(newStock);
                 cout << "✓ Successfully loaded " << symbol << "!" << endl;
             } else {
                 cout << "✗ Failed to load stock." << endl;
@@ -222,23 +340,24 @@ int main() {
                 cout << "\nNo stocks loaded yet." << endl;
             } else {
                 cout << "\n=== Loaded Stocks ===" << endl;
-                for (const auto& pair : stocks) {
-                    cout << "- " << pair.first << endl;
+                for (const Stock* stock : stocks.getStocks()) {
+                    cout << "- " << stock->getSymbol() << endl;
                 }
                 
                 string symbol;
                 cout << "Enter symbol to view: ";
                 cin >> symbol;
                 
-                if (stocks.find(symbol) != stocks.end()) {
-                    stocks[symbol]->displaySummary();
+                Stock* stock = stocks.find(symbol);
+                if (stock != nullptr) {
+                    stock->displaySummary();
                     
                     int days;
                     cout << "\nShow recent days (0 to skip): ";
                     cin >> days;
                     
                     if (days > 0) {
-                        stocks[symbol]->displayRecentData(days);
+                        stock->displayRecentData(days);
                     }
                 } else {
                     cout << "Stock not found." << endl;
@@ -251,16 +370,16 @@ int main() {
                 cout << "\nNo stocks loaded yet." << endl;
             } else {
                 cout << "\n=== Loaded Stocks ===" << endl;
-                for (const auto& pair : stocks) {
-                    cout << "- " << pair.first << endl;
+                for (const Stock* stock : stocks.getStocks()) {
+                    cout << "- " << stock->getSymbol() << endl;
                 }
                 
                 string symbol;
                 cout << "Enter symbol: ";
                 cin >> symbol;
                 
-                if (stocks.find(symbol) != stocks.end()) {
-                    Stock* stock = stocks[symbol];
+                Stock* stock = stocks.find(symbol);
+                if (stock != nullptr) {
                     int dataSize = stock->getDataSize();
                     
                     cout << "\n=== Technical Indicators for " << symbol << " ===" << endl;
@@ -427,18 +546,60 @@ int main() {
                 cout << "\nNo stocks loaded yet." << endl;
             } else {
                 cout << "\n=== Loaded Stocks ===" << endl;
-                for (const auto& pair : stocks) {
-                    cout << "- " << pair.first << endl;
+                for (const Stock* stock : stocks.getStocks()) {
+                    cout << "- " << stock->getSymbol() << endl;
                 }
                 
                 string symbol;
-                cout << "Enter symbol: ";
+                cout << "Enter symbol (ALL for rolling analytics of every stock, CORR for correlations): ";
                 cin >> symbol;
                 
-                if (stocks.find(symbol) != stocks.end()) {
-                    Analytics::displayAnalyticsReport(stocks[symbol]);
-                } else {
+                if (symbol == "CORR") {
+                    vector<Stock*> universe = stocks.getStocks();
+                    
+                    char kind;
+                    cout << "Correlation or covariance? (r/c): ";
+                    cin >> kind;
+                    
+                    ReturnMatrix returns = CovarianceEngine::alignReturns(universe);
+                    CovarianceMatrix matrix = CovarianceEngine::compute(returns, kind != 'c' && kind != 'C');
+                    CovarianceEngine::displayMatrix(matrix);
+                    continue;
+                }
+                
+                Stock* stock = stocks.find(symbol);
+                if (symbol != "ALL" && stock == nullptr) {
                     cout << "Stock not found." << endl;
+                    continue;
+                }
+                
+                char showRolling = 'y';
+                if (symbol != "ALL") {
+                    Analytics::displayAnalyticsReport(stock);
+                    cout << "\nShow rolling analytics? (y/n): ";
+                    cin >> showRolling;
+                }
+                if (showRolling != 'y' && showRolling != 'Y') continue;
+                
+                int window;
+                string benchmarkSymbol;
+                cout << "Window (days): ";
+                cin >> window;
+                cout << "Benchmark symbol for beta (or NONE): ";
+                cin >> benchmarkSymbol;
+                
+                const Stock* benchmark = stocks.find(benchmarkSymbol);
+                
+                if (symbol == "ALL") {
+                    vector<Stock*> universe = stocks.getStocks();
+                    RollingAnalytics::displaySummary(RollingAnalytics::computeBatch(universe, window, benchmark));
+                } else {
+                    int numDays;
+                    cout << "How many recent days to display? ";
+                    cin >> numDays;
+                    
+                    RollingMetrics metrics = RollingAnalytics::compute(stock, window, benchmark);
+                    RollingAnalytics::displayResults(metrics, stock, numDays);
                 }
             }
             
@@ -448,15 +609,63 @@ int main() {
                 cout << "\nNo stocks loaded yet." << endl;
             } else {
                 cout << "\n=== Loaded Stocks ===" << endl;
-                for (const auto& pair : stocks) {
-                    cout << "- " << pair.first << endl;
+                for (const Stock* stock : stocks.getStocks()) {
+                    cout << "- " << stock->getSymbol() << endl;
                 }
                 
                 string symbol;
-                cout << "Enter symbol: ";
+                cout << "Enter symbol (or ALL for a portfolio backtest, STREAM to stream a file): ";
                 cin >> symbol;
+                Stock* stock = stocks.find(symbol);
                 
-                if (stocks.find(symbol) != stocks.end()) {
+                if (symbol == "STREAM") {
+                    string filename;
+                    cout << "Enter CSV or .qlc file: ";
+                    cin >> filename;
+                    
+                    string message;
+                    BarReader* reader = BarReader::openFile(filename, message);
+                    if (reader == nullptr) {
+                        cout << "Error: " << message << endl;
+                        continue;
+                    }
+                    
+                    cout << "\n=== Select Strategy ===" << endl;
+                    cout << "1. RSI Strategy (Buy < 30, Sell > 70)" << endl;
+                    cout << "2. Moving Average Crossover" << endl;
+                    cout << "3. Buy and Hold" << endl;
+                    cout << "Enter choice: ";
+                    
+                    int stratChoice;
+                    cin >> stratChoice;
+                    
+                    Strategy* strategy = nullptr;
+                    if (stratChoice == 1) {
+                        strategy = new RSIStrategy();
+                    } else if (stratChoice == 2) {
+                        strategy = new MAStrategy();
+                    } else if (stratChoice == 3) {
+                        strategy = new BuyHoldStrategy();
+                    } else {
+                        cout << "Invalid choice." << endl;
+                        delete reader;
+                        continue;
+                    }
+                    
+                    double initialCash;
+                    cout << "Enter starting cash: $";
+                    cin >> initialCash;
+                    
+                    // Only a window of recent bars is kept in memory
+                    Stock window(filename, filename);
+                    Backtester backtester(&window, strategy, initialCash);
+                    if (backtester.runStreaming(*reader)) {
+                        backtester.displayResults();
+                    }
+                    
+                    delete strategy;
+                    delete reader;
+                } else if (symbol == "ALL") {
                     cout << "\n=== Select Strategy ===" << endl;
                     cout << "1. RSI Strategy (Buy < 30, Sell > 70)" << endl;
                     cout << "2. Moving Average Crossover" << endl;
@@ -466,6 +675,113 @@ int main() {
                     int stratChoice;
                     cin >> stratChoice;
                     
+                    Strategy* strategy = nullptr;
+                    if (stratChoice == 1) {
+                        strategy = new RSIStrategy();
+                    } else if (stratChoice == 2) {
+                        strategy = new MAStrategy();
+                    } else if (stratChoice == 3) {
+                        strategy = new BuyHoldStrategy();
+                    } else {
+                        cout << "Invalid choice." << endl;
+                        continue;
+                    }
+                    
+                    double initialCash;
+                    int rebalanceDays;
+                    cout << "Enter starting cash: $";
+                    cin >> initialCash;
+                    cout << "Rebalance every N days (0 = on signal changes only): ";
+                    cin >> rebalanceDays;
+                    
+                    vector<Stock*> universe = stocks.getStocks();
+                    
+                    PortfolioBacktester backtester(universe, strategy, initialCash, rebalanceDays);
+                    backtester.run();
+                    backtester.displayResults();
+                    
+                    delete strategy;
+                } else if (stock != nullptr) {
+                    cout << "\n=== Select Strategy ===" << endl;
+                    cout << "1. RSI Strategy (Buy < 30, Sell > 70)" << endl;
+                    cout << "2. Moving Average Crossover" << endl;
+                    cout << "3. Buy and Hold" << endl;
+                    cout << "4. Parameter Sweep: RSI (period, oversold, overbought)" << endl;
+                    cout << "5. Parameter Sweep: Moving Average (fast, slow)" << endl;
+                    cout << "6. RSI Trend Rules (Buy RSI < 30 above SMA50, Sell RSI > 70)" << endl;
+                    cout << "7. Walk-Forward: Moving Average (fit on train days, trade the next test days)" << endl;
+                    cout << "8. Monte Carlo: RSI Strategy risk (bootstrapped price paths)" << endl;
+                    cout << "Enter choice: ";
+                    
+                    int stratChoice;
+                    cin >> stratChoice;
+                    
+                    if (stratChoice == 4 || stratChoice == 5) {
+                        double initialCash;
+                        cout << "Enter starting cash: $";
+                        cin >> initialCash;
+                        
+                        ParameterGrid grid;
+                        StrategyFactory factory;
+                        if (stratChoice == 4) {
+                            grid.addRange("period", 5, 30, 1);
+                            grid.addRange("oversold", 15, 40, 5);
+                            grid.addRange("overbought", 60, 85, 5);
+                            factory = ParameterSweep::rsiFactory();
+                        } else {
+                            grid.addRange("fast", 5, 50, 5);
+                            grid.addRange("slow", 20, 200, 10);
+                            factory = ParameterSweep::maFactory();
+                        }
+                        
+                        cout << "\nRunning " << grid.size() << " backtests..." << endl;
+                        vector<SweepResult> results = ParameterSweep::run(stock, grid, factory, initialCash);
+                        ParameterSweep::displayResults(results);
+                        continue;
+                    }
+                    
+                    if (stratChoice == 7) {
+                        int trainDays, testDays;
+                        double initialCash;
+                        cout << "Train window (days): ";
+                        cin >> trainDays;
+                        cout << "Test window (days): ";
+                        cin >> testDays;
+                        cout << "Enter starting cash: $";
+                        cin >> initialCash;
+                        
+                        ParameterGrid grid;
+                        grid.addRange("fast", 5, 50, 5);
+                        grid.addRange("slow", 20, 200, 10);
+                        
+                        cout << "\nOptimizing " << grid.size() << " combinations per window..." << endl;
+                        WalkForwardResult result = WalkForward::run(stock, grid, ParameterSweep::maFactory(),
+                                                                    trainDays, testDays, initialCash);
+                        WalkForward::displayResults(result);
+                        continue;
+                    }
+                    
+                    if (stratChoice == 8) {
+                        MonteCarloConfig config;
+                        cout << "Number of paths: ";
+                        cin >> config.numPaths;
+                        cout << "Block size (days): ";
+                        cin >> config.blockSize;
+                        cout << "Enter starting cash: $";
+                        cin >> config.initialCash;
+                        
+                        ParameterSet params;
+                        params["period"] = 14;
+                        params["oversold"] = 30;
+                        params["overbought"] = 70;
+                        
+                        cout << "\nSimulating " << config.numPaths << " paths..." << endl;
+                        MonteCarloResult result = MonteCarlo::run(stock, ParameterSweep::rsiFactory(),
+                                                                  params, config);
+                        MonteCarlo::displayResults(result);
+                        continue;
+                    }
+                    
                     Strategy* strategy = nullptr;
                     
                     if (stratChoice == 1) {
@@ -474,6 +790,8 @@ int main() {
                         strategy = new MAStrategy();
                     } else if (stratChoice == 3) {
                         strategy = new BuyHoldStrategy();
+                    } else if (stratChoice == 6) {
+                        strategy = new RSITrendRuleStrategy("RSI Trend Rules");
                     } else {
                         cout << "Invalid choice." << endl;
                         continue;
@@ -483,8 +801,30 @@ int main() {
                     cout << "Enter starting cash: $";
                     cin >> initialCash;
                     
+                    char useCosts;
+                    cout << "Include trading costs? (y/n): ";
+                    cin >> useCosts;
+                    
+                    ExecutionModel costs;
+                    if (useCosts == 'y' || useCosts == 'Y') {
+                        double fixedFee, percentFee, slippage;
+                        cout << "Commission per trade: $";
+                        cin >> fixedFee;
+                        cout << "Commission (% of trade value): ";
+                        cin >> percentFee;
+                        cout << "Slippage (% of price): ";
+                        cin >> slippage;
+                        
+                        // Extra slippage of 0.1% per 1% of the day's volume traded
+                        costs.setCommission(fixedFee, percentFee / 100.0);
+                        costs.setSlippage(slippage / 100.0, 0.1);
+                    }
+                    
                     // Run backtest
-                    Backtester backtester(stocks[symbol], strategy, initialCash);
+                    Backtester backtester(stock, strategy, initialCash);
+                    if (useCosts == 'y' || useCosts == 'Y') {
+                        backtester.setExecutionModel(&costs);
+                    }
                     backtester.run();
                     backtester.displayResults();
                     
@@ -498,10 +838,7 @@ int main() {
             // ===== EXIT =====
             cout << "\nThank you for using QuantLab!" << endl;
             
-            // Clean up memory
-            for (auto& pair : stocks) {
-                delete pair.second;
-            }
+            // Clean up memory (the registry deletes the stocks)
             for (Portfolio* p : portfolios) {
                 delete p;
             }
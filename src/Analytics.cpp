@@ -1,5 +1,6 @@
 // Analytics.cpp
 #include "../include/Analytics.h"
+#include "../include/SimdKernels.h"
 #include <iostream>
 #include <iomanip>
 #include <cmath>
@@ -8,18 +9,14 @@ using namespace std;
 
 // Calculate daily returns
 vector<double> Analytics::calculateDailyReturns(const Stock* stock) {
-    vector<double> returns;
-    int dataSize = stock->getDataSize();
+    const Series& closes = stock->getBars().getCloses();
+    int dataSize = closes.size();
+    if (dataSize < 2) return vector<double>();
     
-    for (int i = 1; i < dataSize; i++) {
-        double today = stock->getClosePrice(i);
-        double yesterday = stock->getClosePrice(i - 1);
-        
-        if (yesterday != 0) {
-            double dailyReturn = ((today - yesterday) / yesterday) * 100.0;
-            returns.push_back(dailyReturn);
-        }
-    }
+    // Sized up front, then trimmed if days with no price were skipped
+    vector<double> returns(dataSize - 1);
+    int count = SimdKernels::dailyReturns(closes.data(), dataSize, returns.data());
+    returns.resize(count);
     
     return returns;
 }
@@ -69,32 +66,30 @@ double Analytics::calculateSharpeRatio(const vector<double>& returns, double ris
     return sharpe;
 }
 
-// Calculate Maximum Drawdown
-double Analytics::calculateMaxDrawdown(const Stock* stock) {
-    int dataSize = stock->getDataSize();
-    if (dataSize < 2) return 0.0;
-    
-    double maxDrawdown = 0.0;
-    double peak = stock->getClosePrice(0);
+// Calculate Sortino Ratio
+double Analytics::calculateSortinoRatio(const vector<double>& returns, double riskFreeRate) {
+    if (returns.size() < 2) return 0.0;
     
-    for (int i = 1; i < dataSize; i++) {
-        double currentPrice = stock->getClosePrice(i);
-        
-        // Update peak if current price is higher
-        if (currentPrice > peak) {
-            peak = currentPrice;
-        }
-        
-        // Calculate drawdown from peak
-        double drawdown = ((peak - currentPrice) / peak) * 100.0;
-        
-        // Update max drawdown
-        if (drawdown > maxDrawdown) {
-            maxDrawdown = drawdown;
+    // Downside deviation: root mean square of the negative returns
+    double downsideSum = 0.0;
+    for (double r : returns) {
+        if (r < 0) {
+            downsideSum += r * r;
         }
     }
+    double downsideVol = sqrt(downsideSum / returns.size()) * sqrt(252);
     
-    return maxDrawdown;
+    if (downsideVol == 0.0) return 0.0;
+    
+    double annualizedReturn = calculateMean(returns) * 252;
+    
+    return (annualizedReturn - riskFreeRate) / downsideVol;
+}
+
+// Calculate Maximum Drawdown
+double Analytics::calculateMaxDrawdown(const Stock* stock) {
+    const Series& closes = stock->getBars().getCloses();
+    return SimdKernels::maxDrawdown(closes.data(), closes.size());
 }
 
 // Display analytics report
@@ -113,31 +108,72 @@ void Analytics::displayAnalyticsReport(const Stock* stock) {
     cout << "Total Days: " << stock->getDataSize() << endl;
 }
 
+// Calculate returns of a value series
+vector<double> Analytics::calculateReturns(const Series& values) {
+    int n = values.size();
+    if (n < 2) return vector<double>();
+    
+    vector<double> returns(n - 1);
+    int count = SimdKernels::dailyReturns(values.data(), n, returns.data());
+    returns.resize(count);
+    
+    return returns;
+}
+
+// Calculate exposure: a position bought on day b and sold on day s is
+// held at the close of days b .. s-1
+double Analytics::calculateExposure(const vector<Trade>& trades, int numDays, int firstDay) {
+    if (numDays <= 0) return 0.0;
+    
+    int daysInMarket = 0;
+    int openDay = -1;
+    for (const Trade& trade : trades) {
+        if (trade.side == TRADE_BUY) {
+            openDay = trade.day;
+        } else if (openDay >= 0) {
+            daysInMarket += trade.day - openDay;
+            openDay = -1;
+        }
+    }
+    if (openDay >= 0) {
+        daysInMarket += (firstDay + numDays) - openDay;
+    }
+    
+    return (static_cast<double>(daysInMarket) / numDays) * 100.0;
+}
+
+// Calculate turnover
+double Analytics::calculateTurnover(const vector<Trade>& trades, const Series& equityCurve) {
+    if (equityCurve.empty()) return 0.0;
+    
+    double tradedValue = 0.0;
+    for (const Trade& trade : trades) {
+        tradedValue += trade.shares * trade.price;
+    }
+    
+    double mean, variance;
+    SimdKernels::meanVariance(equityCurve.data(), equityCurve.size(), mean, variance);
+    
+    return (mean > 0) ? tradedValue / mean : 0.0;
+}
+
 // Helper: Calculate mean
 double Analytics::calculateMean(const vector<double>& data) {
     if (data.empty()) return 0.0;
     
-    double sum = 0.0;
-    for (double val : data) {
-        sum += val;
-    }
+    double mean, variance;
+    SimdKernels::meanVariance(data.data(), data.size(), mean, variance);
     
-    return sum / data.size();
+    return mean;
 }
 
 // Helper: Calculate standard deviation
 double Analytics::calculateStdDev(const vector<double>& data) {
     if (data.size() < 2) return 0.0;
     
-    double mean = calculateMean(data);
-    double variance = 0.0;
-    
-    for (double val : data) {
-        double diff = val - mean;
-        variance += diff * diff;
-    }
-    
-    variance /= data.size();
+    // Single pass over the data
+    double mean, variance;
+    SimdKernels::meanVariance(data.data(), data.size(), mean, variance);
     
     return sqrt(variance);
 }
\ No newline at end of file
@@ -1,11 +1,18 @@
 // Backtester.cpp
 #include "../include/Backtester.h"
+#include "../include/Analytics.h"
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
 
 using namespace std;
 
+// Streaming mode: bars read per chunk, and the smallest window kept
+// (covers fixed warm-ups such as Buy and Hold's day 50)
+static const int STREAM_CHUNK_BARS = 4096;
+static const int STREAM_MIN_WINDOW = 256;
+
 Backtester::Backtester(Stock* s, Strategy* strat, double initialCash) {
     stock = s;
     strategy = strat;
@@ -17,84 +24,361 @@ Backtester::Backtester(Stock* s, Strategy* strat, double initialCash) {
     numTrades = 0;
     winningTrades = 0;
     maxDrawdown = 0.0;
+    presetSignals = nullptr;
+    execution = nullptr;
+    rangeStart = 0;
+    rangeEnd = -1;
+    orderPending = false;
+    pendingSide = TRADE_BUY;
+    pendingTrigger = 0.0;
+    pendingDay = 0;
+    totalCommission = 0.0;
+    totalSlippage = 0.0;
+}
+
+void Backtester::setStrategy(Strategy* strat) {
+    strategy = strat;
+}
+
+void Backtester::setRange(int startDay, int endDay) {
+    rangeStart = startDay;
+    rangeEnd = endDay;
+}
+
+void Backtester::setExecutionModel(const ExecutionModel* model) {
+    execution = model;
 }
 
-void Backtester::run() {
+void Backtester::setSignals(const vector<int8_t>* signals) {
+    presetSignals = signals;
+}
+
+// Helper: clear results, keeping the storage of earlier runs
+void Backtester::reset() {
+    cash = startingCash;
+    shares = 0;
+    trades.clear();
+    equityCurve.clear();
+    finalValue = 0.0;
+    totalReturn = 0.0;
+    numTrades = 0;
+    winningTrades = 0;
+    maxDrawdown = 0.0;
+    totalCommission = 0.0;
+    totalSlippage = 0.0;
+    orderPending = false;
+}
+
+void Backtester::run(bool verbose) {
     int dataSize = stock->getDataSize();
     bool holding = false;
     double buyPrice = 0.0;
     double peak = startingCash;
     
-    cout << "\nRunning backtest for: " << strategy->getName() << endl;
-    cout << "Starting cash: $" << startingCash << endl;
-    cout << "Stock: " << stock->getSymbol() << endl;
-    cout << "Processing..." << endl;
+    if (verbose) {
+        cout << "\nRunning backtest for: " << strategy->getName() << endl;
+        cout << "Starting cash: $" << startingCash << endl;
+        cout << "Stock: " << stock->getSymbol() << endl;
+        cout << "Processing..." << endl;
+    }
+    
+    // Whole signal array up front (cached by the strategy between runs)
+    const vector<int8_t>& signals =
+        (presetSignals != nullptr && (int)presetSignals->size() == dataSize) ? *presetSignals
+                                                                        : strategy->getSignals(stock);
+    const double* closes = stock->getBars().getCloses().data();
+    
+    // Day range to run over
+    int first = max(0, min(rangeStart, dataSize));
+    int last = (rangeEnd < 0) ? dataSize : max(first, min(rangeEnd, dataSize));
+    int numDays = last - first;
+    
+    // All recording storage is sized before the loop (at most one trade per day)
+    reset();
+    trades.reserve(numDays);
+    equityCurve.resize(numDays);
+    double* equity = equityCurve.data();
+    
+    // Go through each day (the cost-free loop stays branch-free)
+    if (execution == nullptr) {
+        for (int day = first; day < last; day++) {
+            equity[day - first] = processDay(day, closes[day], signals[day], holding, buyPrice, peak);
+        }
+    } else {
+        const BarStore& bars = stock->getBars();
+        for (int day = first; day < last; day++) {
+            equity[day - first] = processDayExecuted(day, bars, day, signals[day], holding, buyPrice, peak);
+        }
+    }
+    
+    if (numDays > 0) {
+        finish(last - 1, closes[last - 1], stock->getBars().getVolume(last - 1), holding, buyPrice);
+    } else {
+        finish(0, 0.0, 0, holding, buyPrice);
+    }
+    
+    if (verbose) {
+        cout << "✓ Backtest complete!" << endl;
+    }
+}
+
+// Bounded-memory backtest over bars from a reader
+bool Backtester::runStreaming(BarReader& reader, int windowBars, bool verbose) {
+    if (stock->getDataSize() != 0) {
+        cout << "Error: streaming backtest needs an empty stock" << endl;
+        return false;
+    }
+    
+    bool holding = false;
+    double buyPrice = 0.0;
+    double peak = startingCash;
+    
+    if (verbose) {
+        cout << "\nRunning streaming backtest for: " << strategy->getName() << endl;
+        cout << "Starting cash: $" << startingCash << endl;
+        cout << "Stock: " << stock->getSymbol() << endl;
+        cout << "Processing..." << endl;
+    }
+    
+    reset();
+    
+    // Register the strategy's indicators before the first bar, so they
+    // are extended bar by bar instead of computed over a trimmed window
+    strategy->prepare(stock);
+    int window = max(windowBars, max(STREAM_MIN_WINDOW, stock->getIndicatorLookback() + 1));
+    
+    BarStore chunk;
+    int day = 0;
+    double lastPrice = 0.0;
+    long long lastVolume = 0;
     
-    // Go through each day
-    for (int day = 0; day < dataSize; day++) {
-        double currentPrice = stock->getClosePrice(day);
+    while (reader.readChunk(chunk, STREAM_CHUNK_BARS) > 0) {
+        for (int i = 0; i < chunk.size(); i++) {
+            double currentPrice = chunk.getClose(i);
+            if (!stock->appendBar(chunk.getDate(i), chunk.getOpen(i), chunk.getHigh(i),
+                                  chunk.getLow(i), currentPrice, chunk.getVolume(i))) {
+                return false;
+            }
+            
+            // Only the signal that can act today is evaluated (index within the window)
+            int latest = stock->getDataSize() - 1;
+            int8_t signal = SIGNAL_HOLD;
+            if (!holding && strategy->shouldBuy(stock, latest, false)) {
+                signal = SIGNAL_BUY;
+            } else if (holding && strategy->shouldSell(stock, latest, true)) {
+                signal = SIGNAL_SELL;
+            }
+            
+            if (execution == nullptr) {
+                processDay(day, currentPrice, signal, holding, buyPrice, peak);
+            } else {
+                processDayExecuted(day, chunk, i, signal, holding, buyPrice, peak);
+            }
+            lastPrice = currentPrice;
+            lastVolume = chunk.getVolume(i);
+            day++;
+            
+            // Trim back to the window once it has doubled (amortized O(1) per bar)
+            if (stock->getDataSize() >= 2 * window) {
+                stock->trimFront(stock->getDataSize() - window);
+            }
+        }
+    }
+    
+    finish(day - 1, lastPrice, lastVolume, holding, buyPrice);
+    
+    if (verbose) {
+        cout << "✓ Backtest complete! (" << day << " bars, window of " << window << ")" << endl;
+    }
+    
+    return true;
+}
+
+// Helper: one day of the trading loop
+double Backtester::processDay(int day, double currentPrice, int8_t signal, bool& holding, double& buyPrice, double& peak) {
+    // Check buy signal
+    if (!holding && (signal & SIGNAL_BUY)) {
+        // Calculate how many shares we can buy
+        int sharesToBuy = cash / currentPrice;
         
-        // Check buy signal
-        if (strategy->shouldBuy(stock, day, holding)) {
-            // Calculate how many shares we can buy
-            int sharesToBuy = cash / currentPrice;
+        if (sharesToBuy > 0) {
+            double cost = sharesToBuy * currentPrice;
+            cash -= cost;
+            shares = sharesToBuy;
+            holding = true;
+            buyPrice = currentPrice;
             
-            if (sharesToBuy > 0) {
-                double cost = sharesToBuy * currentPrice;
-                cash -= cost;
-                shares = sharesToBuy;
-                holding = true;
-                buyPrice = currentPrice;
-                
-                Trade t;
-                t.day = day;
-                t.type = "BUY";
-                t.price = currentPrice;
-                t.shares = sharesToBuy;
-                trades.push_back(t);
-                numTrades++;
+            Trade t;
+            t.day = day;
+            t.side = TRADE_BUY;
+            t.price = currentPrice;
+            t.shares = sharesToBuy;
+            trades.push_back(t);
+            numTrades++;
+        }
+    }
+    // Check sell signal
+    else if (holding && (signal & SIGNAL_SELL)) {
+        if (shares > 0) {
+            double revenue = shares * currentPrice;
+            cash += revenue;
+            
+            // Check if winning trade
+            if (currentPrice > buyPrice) {
+                winningTrades++;
             }
+            
+            Trade t;
+            t.day = day;
+            t.side = TRADE_SELL;
+            t.price = currentPrice;
+            t.shares = shares;
+            trades.push_back(t);
+            numTrades++;
+            
+            shares = 0;
+            holding = false;
         }
-        // Check sell signal
-        else if (strategy->shouldSell(stock, day, holding)) {
-            if (shares > 0) {
-                double revenue = shares * currentPrice;
-                cash += revenue;
-                
-                // Check if winning trade
-                if (currentPrice > buyPrice) {
-                    winningTrades++;
-                }
-                
-                Trade t;
-                t.day = day;
-                t.type = "SELL";
-                t.price = currentPrice;
-                t.shares = shares;
-                trades.push_back(t);
-                numTrades++;
-                
-                shares = 0;
-                holding = false;
+    }
+    
+    // Calculate current portfolio value
+    double portfolioValue = cash + (shares * currentPrice);
+    
+    // Track max drawdown
+    if (portfolioValue > peak) {
+        peak = portfolioValue;
+    }
+    double drawdown = ((peak - portfolioValue) / peak) * 100.0;
+    if (drawdown > maxDrawdown) {
+        maxDrawdown = drawdown;
+    }
+    
+    return portfolioValue;
+}
+
+// Helper: one day with trading costs and limit/stop orders.
+// A limit/stop order is placed at the signal day's close and can fill
+// from the next bar on; new signals are ignored while it is pending.
+double Backtester::processDayExecuted(int day, const BarStore& bars, int index, int8_t signal,
+                                      bool& holding, double& buyPrice, double& peak) {
+    double currentPrice = bars.getClose(index);
+    long long volume = bars.getVolume(index);
+    
+    if (orderPending) {
+        double fillPrice;
+        if (day > pendingDay &&
+            execution->tryFill(pendingSide, pendingTrigger, bars.getOpen(index),
+                               bars.getHigh(index), bars.getLow(index), fillPrice)) {
+            // Stops become market orders once triggered and pay slippage
+            bool withSlippage = (execution->getOrderType(pendingSide) == ORDER_STOP);
+            if (pendingSide == TRADE_BUY) {
+                executeBuy(day, fillPrice, volume, withSlippage, holding, buyPrice);
+            } else {
+                executeSell(day, fillPrice, volume, withSlippage, holding, buyPrice);
             }
+            orderPending = false;
+        } else if (day - pendingDay >= execution->getOrderExpiryDays()) {
+            orderPending = false;  // Expired
         }
+    } else {
+        bool buySignal = !holding && (signal & SIGNAL_BUY);
+        bool sellSignal = holding && (signal & SIGNAL_SELL);
         
-        // Calculate current portfolio value
-        double portfolioValue = cash + (shares * currentPrice);
-        
-        // Track max drawdown
-        if (portfolioValue > peak) {
-            peak = portfolioValue;
-        }
-        double drawdown = ((peak - portfolioValue) / peak) * 100.0;
-        if (drawdown > maxDrawdown) {
-            maxDrawdown = drawdown;
+        if (buySignal || sellSignal) {
+            TradeSide side = buySignal ? TRADE_BUY : TRADE_SELL;
+            
+            if (execution->getOrderType(side) == ORDER_MARKET) {
+                if (buySignal) {
+                    executeBuy(day, currentPrice, volume, true, holding, buyPrice);
+                } else {
+                    executeSell(day, currentPrice, volume, true, holding, buyPrice);
+                }
+            } else {
+                orderPending = true;
+                pendingSide = side;
+                pendingTrigger = execution->triggerPrice(side, currentPrice);
+                pendingDay = day;
+            }
         }
     }
     
+    // Calculate current portfolio value
+    double portfolioValue = cash + (shares * currentPrice);
+    
+    // Track max drawdown
+    if (portfolioValue > peak) {
+        peak = portfolioValue;
+    }
+    double drawdown = ((peak - portfolioValue) / peak) * 100.0;
+    if (drawdown > maxDrawdown) {
+        maxDrawdown = drawdown;
+    }
+    
+    return portfolioValue;
+}
+
+// Helper: buy as many shares as cash allows after costs.
+// buyPrice becomes the cost per share including commission.
+void Backtester::executeBuy(int day, double price, long long volume, bool withSlippage, bool& holding, double& buyPrice) {
+    int sharesToBuy = execution->affordableShares(cash, price, volume, withSlippage);
+    if (sharesToBuy <= 0) return;
+    
+    double fillPrice = withSlippage ? execution->slippedPrice(TRADE_BUY, price, sharesToBuy, volume) : price;
+    double fee = execution->commission(sharesToBuy, fillPrice);
+    double cost = (sharesToBuy * fillPrice) + fee;
+    
+    cash -= cost;
+    shares = sharesToBuy;
+    holding = true;
+    buyPrice = cost / sharesToBuy;
+    totalCommission += fee;
+    totalSlippage += sharesToBuy * (fillPrice - price);
+    
+    Trade t;
+    t.day = day;
+    t.side = TRADE_BUY;
+    t.price = fillPrice;
+    t.shares = sharesToBuy;
+    trades.push_back(t);
+    numTrades++;
+}
+
+// Helper: sell the whole position after costs
+void Backtester::executeSell(int day, double price, long long volume, bool withSlippage, bool& holding, double& buyPrice) {
+    if (shares <= 0) return;
+    
+    double fillPrice = withSlippage ? execution->slippedPrice(TRADE_SELL, price, shares, volume) : price;
+    double fee = execution->commission(shares, fillPrice);
+    double revenue = (shares * fillPrice) - fee;
+    
+    cash += revenue;
+    totalCommission += fee;
+    totalSlippage += shares * (price - fillPrice);
+    
+    // Winning trade after costs
+    if (revenue / shares > buyPrice) {
+        winningTrades++;
+    }
+    
+    Trade t;
+    t.day = day;
+    t.side = TRADE_SELL;
+    t.price = fillPrice;
+    t.shares = shares;
+    trades.push_back(t);
+    numTrades++;
+    
+    shares = 0;
+    holding = false;
+}
+
+// Helper: close the position at the last price (after costs when an
+// execution model is set)
+void Backtester::finish(int lastDay, double lastPrice, long long lastVolume, bool& holding, double& buyPrice) {
     // If still holding at end, sell at last price
-    if (shares > 0) {
-        double lastPrice = stock->getClosePrice(dataSize - 1);
+    if (shares > 0 && execution != nullptr) {
+        executeSell(lastDay, lastPrice, lastVolume, true, holding, buyPrice);
+    } else if (shares > 0) {
         cash += shares * lastPrice;
         shares = 0;
     }
@@ -102,8 +386,6 @@ void Backtester::run() {
     // Calculate final results
     finalValue = cash;
     totalReturn = ((finalValue - startingCash) / startingCash) * 100.0;
-    
-    cout << "✓ Backtest complete!" << endl;
 }
 
 void Backtester::displayResults() const {
@@ -120,9 +402,21 @@ void Backtester::displayResults() const {
     cout << "  Final Value: $" << finalValue << endl;
     cout << "  Total Return: " << totalReturn << "%" << endl;
     cout << "  Max Drawdown: " << maxDrawdown << "%" << endl;
+    if (!equityCurve.empty()) {
+        cout << "  Sharpe Ratio: " << getSharpeRatio() << endl;
+        cout << "  Sortino Ratio: " << getSortinoRatio() << endl;
+    }
     
     cout << "\nTrading Activity:" << endl;
     cout << "  Total Trades: " << numTrades << endl;
+    if (!equityCurve.empty()) {
+        cout << "  Exposure: " << getExposure() << "%" << endl;
+        cout << "  Turnover: " << getTurnover() << "x" << endl;
+    }
+    if (execution != nullptr) {
+        cout << "  Commissions: $" << totalCommission << endl;
+        cout << "  Slippage: $" << totalSlippage << endl;
+    }
     
     if (numTrades > 0) {
         int completedTrades = numTrades / 2;  // Buy + Sell = 1 complete trade
@@ -139,7 +433,7 @@ void Backtester::displayResults() const {
         int start = max(0, (int)trades.size() - 5);
         for (int i = start; i < trades.size(); i++) {
             cout << "  Day " << trades[i].day << ": " 
-                 << trades[i].type << " " 
+                 << tradeSideName(trades[i].side) << " " 
                  << trades[i].shares << " shares @ $" 
                  << trades[i].price << endl;
         }
@@ -154,4 +448,48 @@ double Backtester::getTotalReturn() const {
 
 double Backtester::getFinalValue() const {
     return finalValue;
+}
+
+double Backtester::getMaxDrawdown() const {
+    return maxDrawdown;
+}
+
+int Backtester::getNumTrades() const {
+    return numTrades;
+}
+
+int Backtester::getWinningTrades() const {
+    return winningTrades;
+}
+
+double Backtester::getTotalCommission() const {
+    return totalCommission;
+}
+
+double Backtester::getTotalSlippage() const {
+    return totalSlippage;
+}
+
+const vector<Trade>& Backtester::getTrades() const {
+    return trades;
+}
+
+const Series& Backtester::getEquityCurve() const {
+    return equityCurve;
+}
+
+double Backtester::getSharpeRatio() const {
+    return Analytics::calculateSharpeRatio(Analytics::calculateReturns(equityCurve));
+}
+
+double Backtester::getSortinoRatio() const {
+    return Analytics::calculateSortinoRatio(Analytics::calculateReturns(equityCurve));
+}
+
+double Backtester::getExposure() const {
+    return Analytics::calculateExposure(trades, equityCurve.size(), max(0, rangeStart));
+}
+
+double Backtester::getTurnover() const {
+    return Analytics::calculateTurnover(trades, equityCurve);
 }
\ No newline at end of file
@@ -0,0 +1,281 @@
+// BarReader.cpp
+#include "../include/BarReader.h"
+#include "../include/PriceCache.h"
+#include "../include/DateUtil.h"
+#include <cstring>
+#include <charconv>
+#include <algorithm>
+
+using namespace std;
+
+// Helper: skip spaces/tabs at the start of a field
+static const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        p++;
+    }
+    return p;
+}
+
+// Helper: find the end of the current field (next comma or end of line)
+static const char* fieldEnd(const char* p, const char* end) {
+    const char* comma = static_cast<const char*>(memchr(p, ',', end - p));
+    return comma ? comma : end;
+}
+
+// Helper: parse a number in place, ignoring leading spaces
+template <typename T>
+static bool parseNumber(const char*& p, const char* lineEnd, T& value) {
+    const char* stop = fieldEnd(p, lineEnd);
+    const char* start = skipSpaces(p, stop);
+    
+    // Like stod/stoll: leading '+' is allowed and anything after the number is ignored
+    if (start < stop && *start == '+') {
+        start++;
+    }
+    
+    from_chars_result result = from_chars(start, stop, value);
+    if (result.ec != errc()) {
+        return false;
+    }
+    
+    p = (stop < lineEnd) ? stop + 1 : stop;
+    return true;
+}
+
+// Helper: true if the file name ends with the given extension
+static bool hasExtension(const string& filename, const string& extension) {
+    return filename.size() >= extension.size() &&
+           filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+// Pick a reader by file extension
+BarReader* BarReader::openFile(const string& filename, string& message) {
+    if (hasExtension(filename, ".qlc")) {
+        BinaryBarReader* reader = new BinaryBarReader();
+        if (!reader->open(filename)) {
+            message = "Could not open " + filename + " as a binary price file";
+            delete reader;
+            return nullptr;
+        }
+        return reader;
+    }
+    
+    CSVBarReader* reader = new CSVBarReader();
+    if (!reader->open(filename)) {
+        message = "Could not open " + filename;
+        delete reader;
+        return nullptr;
+    }
+    return reader;
+}
+
+// ===== CSV reader =====
+
+CSVBarReader::CSVBarReader(size_t bufferBytes) {
+    file = nullptr;
+    buffer.resize(max(bufferBytes, (size_t)4096));
+    bufferStart = 0;
+    bufferEnd = 0;
+    endOfFile = false;
+    lineNumber = 0;
+    skippedLines = 0;
+}
+
+CSVBarReader::~CSVBarReader() {
+    close();
+}
+
+bool CSVBarReader::open(const string& filename) {
+    close();
+    file = fopen(filename.c_str(), "rb");
+    bufferStart = 0;
+    bufferEnd = 0;
+    endOfFile = (file == nullptr);
+    lineNumber = 0;
+    skippedLines = 0;
+    return file != nullptr;
+}
+
+void CSVBarReader::close() {
+    if (file != nullptr) {
+        fclose(file);
+        file = nullptr;
+    }
+    endOfFile = true;
+}
+
+int CSVBarReader::getSkippedLines() const {
+    return skippedLines;
+}
+
+// Helper: keep the partial line, grow the buffer if a line doesn't fit
+void CSVBarReader::refill() {
+    size_t pending = bufferEnd - bufferStart;
+    memmove(buffer.data(), buffer.data() + bufferStart, pending);
+    bufferStart = 0;
+    bufferEnd = pending;
+    
+    if (bufferEnd == buffer.size()) {
+        buffer.resize(buffer.size() * 2);
+    }
+    
+    size_t count = fread(buffer.data() + bufferEnd, 1, buffer.size() - bufferEnd, file);
+    bufferEnd += count;
+    if (count == 0) {
+        endOfFile = true;
+    }
+}
+
+int CSVBarReader::readChunk(BarStore& chunk, int maxBars) {
+    chunk.clear();
+    int count = 0;
+    
+    while (count < maxBars) {
+        const char* p = buffer.data() + bufferStart;
+        const char* end = buffer.data() + bufferEnd;
+        const char* nl = static_cast<const char*>(memchr(p, '\n', end - p));
+        
+        if (nl == nullptr) {
+            if (!endOfFile) {
+                refill();
+                continue;
+            }
+            if (p == end) break;
+            nl = end;  // Last line without a newline
+        }
+        
+        const char* lineEnd = nl;
+        bufferStart = (nl < end) ? (nl + 1) - buffer.data() : bufferEnd;
+        
+        // Handle Windows line endings
+        if (lineEnd > p && *(lineEnd - 1) == '\r') {
+            lineEnd--;
+        }
+        
+        lineNumber++;
+        
+        // Skip header and blank lines
+        if (lineNumber == 1 || isBlankLine(p, lineEnd)) {
+            continue;
+        }
+        
+        int date;
+        double open, high, low, close;
+        long long volume;
+        if (!parseLine(p, lineEnd, date, open, high, low, close, volume)) {
+            skippedLines++;
+            continue;
+        }
+        
+        chunk.append(date, open, high, low, close, volume);
+        count++;
+    }
+    
+    return count;
+}
+
+bool CSVBarReader::isBlankLine(const char* p, const char* lineEnd) {
+    return skipSpaces(p, lineEnd) == lineEnd;
+}
+
+// Every field is parsed in place, the date into days since epoch
+bool CSVBarReader::parseLine(const char* p, const char* lineEnd, int& date, double& open,
+                             double& high, double& low, double& close, long long& volume) {
+    const char* dateStop = fieldEnd(p, lineEnd);
+    const char* dateStart = skipSpaces(p, dateStop);
+    const char* dateEnd = dateStop;
+    while (dateEnd > dateStart && (*(dateEnd - 1) == ' ' || *(dateEnd - 1) == '\t')) {
+        dateEnd--;
+    }
+    
+    const char* field = (dateStop < lineEnd) ? dateStop + 1 : dateStop;
+    
+    return DateUtil::parseDate(dateStart, dateEnd, date) &&
+           parseNumber(field, lineEnd, open) &&
+           parseNumber(field, lineEnd, high) &&
+           parseNumber(field, lineEnd, low) &&
+           parseNumber(field, lineEnd, close) &&
+           parseNumber(field, lineEnd, volume);
+}
+
+// ===== Binary reader =====
+
+BinaryBarReader::BinaryBarReader() {
+    file = nullptr;
+    rows = 0;
+    nextRow = 0;
+}
+
+BinaryBarReader::~BinaryBarReader() {
+    close();
+}
+
+bool BinaryBarReader::open(const string& filename) {
+    close();
+    file = fopen(filename.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    
+    PriceCacheHeader header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 && fseeko(file, 0, SEEK_END) == 0;
+    off_t fileBytes = ok ? ftello(file) : -1;
+    
+    if (!ok || fileBytes < 0 || !PriceCache::validHeader(header, fileBytes)) {
+        close();
+        return false;
+    }
+    
+    rows = header.rows;
+    nextRow = 0;
+    return true;
+}
+
+void BinaryBarReader::close() {
+    if (file != nullptr) {
+        fclose(file);
+        file = nullptr;
+    }
+    rows = 0;
+    nextRow = 0;
+}
+
+uint64_t BinaryBarReader::getRows() const {
+    return rows;
+}
+
+// Helper: one seek + read per column and chunk
+bool BinaryBarReader::readColumn(int column, size_t valueSize, void* out, size_t count) {
+    off_t offset = PriceCache::columnOffset(column, rows) + nextRow * valueSize;
+    return fseeko(file, offset, SEEK_SET) == 0 && fread(out, valueSize, count, file) == count;
+}
+
+int BinaryBarReader::readChunk(BarStore& chunk, int maxBars) {
+    chunk.clear();
+    if (file == nullptr || nextRow >= rows || maxBars <= 0) {
+        return 0;
+    }
+    
+    size_t count = min((uint64_t)maxBars, rows - nextRow);
+    dates.resize(count);
+    opens.resize(count);
+    highs.resize(count);
+    lows.resize(count);
+    closes.resize(count);
+    volumes.resize(count);
+    
+    bool ok = readColumn(0, sizeof(int32_t), dates.data(), count) &&
+              readColumn(1, sizeof(double), opens.data(), count) &&
+              readColumn(2, sizeof(double), highs.data(), count) &&
+              readColumn(3, sizeof(double), lows.data(), count) &&
+              readColumn(4, sizeof(double), closes.data(), count) &&
+              readColumn(5, sizeof(int64_t), volumes.data(), count);
+    if (!ok) {
+        close();
+        return 0;
+    }
+    
+    chunk.append(dates.data(), opens.data(), highs.data(), lows.data(), closes.data(), volumes.data(), count);
+    nextRow += count;
+    return count;
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+// BarStore.cpp
+#include "../include/BarStore.h"
+#include <algorithm>
+
+using namespace std;
+
+// Constructor
+BarStore::BarStore() {}
+
+// Reserve room for more bars in every column
+void BarStore::reserve(size_t bars) {
+    dates.reserve(bars);
+    openPrices.reserve(bars);
+    highPrices.reserve(bars);
+    lowPrices.reserve(bars);
+    closePrices.reserve(bars);
+    volumes.reserve(bars);
+}
+
+void BarStore::clear() {
+    dates.clear();
+    openPrices.clear();
+    highPrices.clear();
+    lowPrices.clear();
+    closePrices.clear();
+    volumes.clear();
+}
+
+// Drop the oldest bars from every column
+void BarStore::eraseFront(int count) {
+    count = min(count, size());
+    dates.erase(dates.begin(), dates.begin() + count);
+    openPrices.erase(openPrices.begin(), openPrices.begin() + count);
+    highPrices.erase(highPrices.begin(), highPrices.begin() + count);
+    lowPrices.erase(lowPrices.begin(), lowPrices.begin() + count);
+    closePrices.erase(closePrices.begin(), closePrices.begin() + count);
+    volumes.erase(volumes.begin(), volumes.begin() + count);
+}
+
+int BarStore::size() const {
+    return dates.size();
+}
+
+bool BarStore::empty() const {
+    return dates.empty();
+}
+
+// Add one bar
+void BarStore::append(int date, double open, double high, double low, double close, long long volume) {
+    dates.push_back(date);
+    openPrices.push_back(open);
+    highPrices.push_back(high);
+    lowPrices.push_back(low);
+    closePrices.push_back(close);
+    volumes.push_back(volume);
+}
+
+// Add a block of bars column by column
+void BarStore::append(const int* date, const double* open, const double* high,
+                      const double* low, const double* close, const long long* volume, size_t count) {
+    dates.insert(dates.end(), date, date + count);
+    openPrices.insert(openPrices.end(), open, open + count);
+    highPrices.insert(highPrices.end(), high, high + count);
+    lowPrices.insert(lowPrices.end(), low, low + count);
+    closePrices.insert(closePrices.end(), close, close + count);
+    volumes.insert(volumes.end(), volume, volume + count);
+}
+
+// Column getters
+const AlignedVector<int>& BarStore::getDates() const {
+    return dates;
+}
+
+const Series& BarStore::getOpens() const {
+    return openPrices;
+}
+
+const Series& BarStore::getHighs() const {
+    return highPrices;
+}
+
+const Series& BarStore::getLows() const {
+    return lowPrices;
+}
+
+const Series& BarStore::getCloses() const {
+    return closePrices;
+}
+
+const AlignedVector<long long>& BarStore::getVolumes() const {
+    return volumes;
+}
@@ -0,0 +1,291 @@
+// CovarianceEngine.cpp
+#include "../include/CovarianceEngine.h"
+#include "../include/SimdKernels.h"
+#include "../include/ThreadPool.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// Tile sizes: a 64-symbol x 128-day panel is 64 KB, so the (up to six)
+// panels of a tile stay in L2
+static const int TILE_SYMBOLS = 64;
+static const int TILE_DAYS = 128;
+
+// Helper: copy days x width values of a [day][symbol] matrix into a
+// contiguous panel with rows of TILE_SYMBOLS. Rows of the full matrix can
+// be far apart, so working on packed panels avoids a TLB miss per row.
+static void packPanel(const double* source, int stride, int dayStart, int days,
+                      int symbolStart, int width, double* out) {
+    for (int d = 0; d < days; d++) {
+        const double* row = source + (size_t)(dayStart + d) * stride + symbolStart;
+        copy(row, row + width, out + d * TILE_SYMBOLS);
+    }
+}
+
+ReturnMatrix CovarianceEngine::alignReturns(const vector<Stock*>& stocks) {
+    ReturnMatrix data;
+    data.numSymbols = stocks.size();
+    data.stride = (data.numSymbols + 7) / 8 * 8;
+    data.complete = true;
+    
+    // Union of all dates
+    vector<int> dates;
+    for (Stock* stock : stocks) {
+        data.symbols.push_back(stock->getSymbol());
+        const AlignedVector<int>& stockDates = stock->getBars().getDates();
+        dates.insert(dates.end(), stockDates.begin(), stockDates.end());
+    }
+    sort(dates.begin(), dates.end());
+    dates.erase(unique(dates.begin(), dates.end()), dates.end());
+    
+    // Row d holds the returns from dates[d] to dates[d + 1]
+    if (dates.size() < 2) return data;
+    data.timeline.assign(dates.begin() + 1, dates.end());
+    int numDays = data.timeline.size();
+    
+    data.returns.assign((size_t)numDays * data.stride, 0.0);
+    data.mask.assign((size_t)numDays * data.stride, 0.0);
+    data.observations.assign(data.numSymbols, 0);
+    
+    // Symbols are columns, so writing one symbol at a time would touch a
+    // different row (and page) for every value. Instead each group of
+    // TILE_SYMBOLS symbols is built symbol-major in a staging buffer and
+    // then copied out one contiguous row segment per day.
+    AlignedVector<double> staged((size_t)TILE_SYMBOLS * numDays);
+    AlignedVector<double> stagedMask((size_t)TILE_SYMBOLS * numDays);
+    for (int groupStart = 0; groupStart < data.numSymbols; groupStart += TILE_SYMBOLS) {
+        int width = min(TILE_SYMBOLS, data.numSymbols - groupStart);
+        fill(staged.begin(), staged.end(), 0.0);
+        fill(stagedMask.begin(), stagedMask.end(), 0.0);
+        
+        for (int g = 0; g < width; g++) {
+            int s = groupStart + g;
+            const BarStore& bars = stocks[s]->getBars();
+            double* column = staged.data() + (size_t)g * numDays;
+            double* columnMask = stagedMask.data() + (size_t)g * numDays;
+            int day = 0;
+            int count = 0;
+            double sum = 0.0;
+            
+            for (int i = 1; i < bars.size(); i++) {
+                int previousDate = bars.getDate(i - 1);
+                int date = bars.getDate(i);
+                double yesterday = bars.getClose(i - 1);
+                if (date <= previousDate) continue;
+                
+                while (day < numDays && data.timeline[day] < date) {
+                    day++;
+                }
+                if (day >= numDays) break;
+                
+                // Only returns between consecutive timeline dates
+                if (dates[day] != previousDate || yesterday == 0) continue;
+                
+                double value = ((bars.getClose(i) - yesterday) / yesterday) * 100.0;
+                column[day] = value;
+                columnMask[day] = 1.0;
+                sum += value;
+                count++;
+            }
+            
+            data.observations[s] = count;
+            if (count < numDays) {
+                data.complete = false;
+            }
+            
+            // Centering keeps the sums small, so the covariance formula
+            // below doesn't lose precision
+            double mean = (count > 0) ? sum / count : 0.0;
+            for (int d = 0; d < numDays; d++) {
+                column[d] -= mean * columnMask[d];
+            }
+        }
+        
+        for (int d = 0; d < numDays; d++) {
+            size_t row = (size_t)d * data.stride + groupStart;
+            for (int g = 0; g < width; g++) {
+                data.returns[row + g] = staged[(size_t)g * numDays + d];
+                data.mask[row + g] = stagedMask[(size_t)g * numDays + d];
+            }
+        }
+    }
+    
+    return data;
+}
+
+// Each entry needs these sums over the days both symbols have a return:
+//   count = sum(mi * mj)       sxy = sum(xi * xj)
+//   sx = sum(xi * mj)          sy = sum(mi * xj)
+//   sxx = sum(xi^2 * mj)       syy = sum(mi * xj^2)
+// Missing returns are stored as 0, so each is a plain matrix product.
+// Without missing data only sxy is needed (count = days, sx = sy = 0
+// after centering, and sxx/syy are each symbol's sum of squares).
+void CovarianceEngine::computeTile(const ReturnMatrix& data, const AlignedVector<double>& squares,
+                                   const vector<double>& sumSquares, int rowStart, int columnStart, bool correlation, int minObservations,
+                                   vector<double>& values) {
+    const int numDays = data.numDays();
+    const int stride = data.stride;
+    const int rows = min(TILE_SYMBOLS, stride - rowStart);
+    const int columns = min(TILE_SYMBOLS, stride - columnStart);
+    const int cells = TILE_SYMBOLS * TILE_SYMBOLS;
+    const bool pairwise = !data.complete;
+    
+    const double* x = data.returns.data();
+    const double* m = data.mask.data();
+    const double* x2 = squares.data();
+    
+    vector<double> sums((pairwise ? 6 : 1) * cells, 0.0);
+    double* sxy = sums.data();
+    double* count = pairwise ? sxy + cells : nullptr;
+    double* sx = pairwise ? sxy + 2 * cells : nullptr;
+    double* sy = pairwise ? sxy + 3 * cells : nullptr;
+    double* sxx = pairwise ? sxy + 4 * cells : nullptr;
+    double* syy = pairwise ? sxy + 5 * cells : nullptr;
+    
+    // Packed panels: returns, mask and squares for the rows and the columns
+    const int panelSize = TILE_DAYS * TILE_SYMBOLS;
+    AlignedVector<double> panels((pairwise ? 6 : 2) * panelSize);
+    double* rowX = panels.data();
+    double* columnX = rowX + panelSize;
+    double* rowM = pairwise ? rowX + 2 * panelSize : nullptr;
+    double* columnM = pairwise ? rowX + 3 * panelSize : nullptr;
+    double* rowX2 = pairwise ? rowX + 4 * panelSize : nullptr;
+    double* columnX2 = pairwise ? rowX + 5 * panelSize : nullptr;
+    
+    for (int dayStart = 0; dayStart < numDays; dayStart += TILE_DAYS) {
+        int days = min(TILE_DAYS, numDays - dayStart);
+        
+        packPanel(x, stride, dayStart, days, rowStart, rows, rowX);
+        packPanel(x, stride, dayStart, days, columnStart, columns, columnX);
+        if (pairwise) {
+            packPanel(m, stride, dayStart, days, rowStart, rows, rowM);
+            packPanel(m, stride, dayStart, days, columnStart, columns, columnM);
+            packPanel(x2, stride, dayStart, days, rowStart, rows, rowX2);
+            packPanel(x2, stride, dayStart, days, columnStart, columns, columnX2);
+        }
+        
+        for (int r = 0; r < rows; r += 4) {
+            for (int c = 0; c < columns; c += 8) {
+                int cell = r * TILE_SYMBOLS + c;
+                
+                SimdKernels::crossProduct4x8(rowX + r, columnX + c, days, TILE_SYMBOLS, sxy + cell, TILE_SYMBOLS);
+                if (pairwise) {
+                    SimdKernels::crossProduct4x8(rowM + r, columnM + c, days, TILE_SYMBOLS, count + cell, TILE_SYMBOLS);
+                    SimdKernels::crossProduct4x8(rowX + r, columnM + c, days, TILE_SYMBOLS, sx + cell, TILE_SYMBOLS);
+                    SimdKernels::crossProduct4x8(rowM + r, columnX + c, days, TILE_SYMBOLS, sy + cell, TILE_SYMBOLS);
+                    SimdKernels::crossProduct4x8(rowX2 + r, columnM + c, days, TILE_SYMBOLS, sxx + cell, TILE_SYMBOLS);
+                    SimdKernels::crossProduct4x8(rowM + r, columnX2 + c, days, TILE_SYMBOLS, syy + cell, TILE_SYMBOLS);
+                }
+            }
+        }
+    }
+    
+    const int n = data.numSymbols;
+    for (int r = 0; r < rows && rowStart + r < n; r++) {
+        for (int c = 0; c < columns && columnStart + c < n; c++) {
+            int i = rowStart + r;
+            int j = columnStart + c;
+            if (j < i) continue;
+            
+            int cell = r * TILE_SYMBOLS + c;
+            double value = 0.0;
+            
+            if (!pairwise) {
+                if (numDays >= minObservations) {
+                    if (!correlation) {
+                        value = sxy[cell] / numDays;
+                    } else {
+                        double denominator = sqrt(sumSquares[i] * sumSquares[j]);
+                        value = (denominator > 0.0) ? sxy[cell] / denominator : 0.0;
+                    }
+                }
+            } else {
+                double k = count[cell];
+                if (k >= minObservations && k > 0) {
+                    double co = sxy[cell] - sx[cell] * sy[cell] / k;
+                    if (!correlation) {
+                        value = co / k;
+                    } else {
+                        double varX = sxx[cell] - sx[cell] * sx[cell] / k;
+                        double varY = syy[cell] - sy[cell] * sy[cell] / k;
+                        double denominator = sqrt(max(0.0, varX) * max(0.0, varY));
+                        value = (denominator > 0.0) ? co / denominator : 0.0;
+                    }
+                }
+            }
+            
+            values[(size_t)i * n + j] = value;
+            values[(size_t)j * n + i] = value;
+        }
+    }
+}
+
+CovarianceMatrix CovarianceEngine::compute(const ReturnMatrix& data, bool correlation,
+                                           int minObservations, int numThreads) {
+    CovarianceMatrix matrix;
+    matrix.symbols = data.symbols;
+    matrix.size = data.numSymbols;
+    matrix.correlation = correlation;
+    matrix.values.assign((size_t)matrix.size * matrix.size, 0.0);
+    if (matrix.size == 0 || data.numDays() == 0) return matrix;
+    
+    // Squared returns for the pairwise variances, or each symbol's sum
+    // of squares when every pair covers the same days
+    AlignedVector<double> squares;
+    vector<double> sumSquares;
+    if (!data.complete) {
+        squares.resize(data.returns.size());
+        for (size_t i = 0; i < squares.size(); i++) {
+            squares[i] = data.returns[i] * data.returns[i];
+        }
+    } else {
+        sumSquares.assign(data.stride, 0.0);
+        for (int d = 0; d < data.numDays(); d++) {
+            const double* row = data.returns.data() + (size_t)d * data.stride;
+            for (int s = 0; s < data.stride; s++) {
+                sumSquares[s] += row[s] * row[s];
+            }
+        }
+    }
+    
+    ThreadPool pool(numThreads);
+    for (int rowStart = 0; rowStart < data.stride; rowStart += TILE_SYMBOLS) {
+        for (int columnStart = rowStart; columnStart < data.stride; columnStart += TILE_SYMBOLS) {
+            pool.submit([&, rowStart, columnStart] {
+                computeTile(data, squares, sumSquares, rowStart, columnStart, correlation, minObservations, matrix.values);
+            });
+        }
+    }
+    pool.waitAll();
+    
+    return matrix;
+}
+
+void CovarianceEngine::displayMatrix(const CovarianceMatrix& matrix, int maxSymbols) {
+    int shown = min(matrix.size, maxSymbols);
+    
+    cout << "\n=== " << (matrix.correlation ? "Correlation" : "Covariance") << " Matrix ("
+         << matrix.size << " symbols) ===" << endl;
+    cout << fixed << setprecision(matrix.correlation ? 2 : 4);
+    
+    cout << "\t";
+    for (int j = 0; j < shown; j++) {
+        cout << matrix.symbols[j] << "\t";
+    }
+    cout << endl;
+    
+    for (int i = 0; i < shown; i++) {
+        cout << matrix.symbols[i] << "\t";
+        for (int j = 0; j < shown; j++) {
+            cout << matrix.values[(size_t)i * matrix.size + j] << "\t";
+        }
+        cout << endl;
+    }
+    
+    if (shown < matrix.size) {
+        cout << "(first " << shown << " of " << matrix.size << " symbols shown)" << endl;
+    }
+}
\ No newline at end of file
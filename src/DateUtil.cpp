@@ -0,0 +1,83 @@
+// DateUtil.cpp
+#include "../include/DateUtil.h"
+#include <cstdio>
+
+using namespace std;
+
+// Helper: read a fixed number of digits
+static bool readDigits(const char* p, int count, int& value) {
+    value = 0;
+    for (int i = 0; i < count; i++) {
+        if (p[i] < '0' || p[i] > '9') return false;
+        value = value * 10 + (p[i] - '0');
+    }
+    return true;
+}
+
+// Parse YYYY-MM-DD, optionally followed by a time (dropped)
+bool DateUtil::parseDate(const char* begin, const char* end, int& days) {
+    if (end - begin < 10 || begin[4] != '-' || begin[7] != '-') {
+        return false;
+    }
+    
+    // "YYYY-MM-DD HH:MM..." or "YYYY-MM-DDTHH:MM...": the time is ignored
+    if (end - begin > 10) {
+        int hour, minute;
+        if (end - begin < 16 || (begin[10] != ' ' && begin[10] != 'T') || begin[13] != ':' ||
+            !readDigits(begin + 11, 2, hour) || !readDigits(begin + 14, 2, minute)) {
+            return false;
+        }
+    }
+    
+    int year, month, day;
+    if (!readDigits(begin, 4, year) ||
+        !readDigits(begin + 5, 2, month) ||
+        !readDigits(begin + 8, 2, day)) {
+        return false;
+    }
+    
+    if (month < 1 || month > 12 || day < 1 || day > 31) {
+        return false;
+    }
+    
+    days = daysFromCivil(year, month, day);
+    return true;
+}
+
+bool DateUtil::parseDate(const string& text, int& days) {
+    return parseDate(text.data(), text.data() + text.size(), days);
+}
+
+// Format as YYYY-MM-DD
+string DateUtil::formatDate(int days) {
+    int year, month, day;
+    civilFromDays(days, year, month, day);
+    
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", year, month, day);
+    return string(buffer);
+}
+
+// Days since 1970-01-01 (proleptic Gregorian calendar)
+int DateUtil::daysFromCivil(int year, int month, int day) {
+    year -= (month <= 2) ? 1 : 0;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yearOfEra = year - era * 400;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// Inverse of daysFromCivil
+void DateUtil::civilFromDays(int days, int& year, int& month, int& day) {
+    days += 719468;
+    int era = (days >= 0 ? days : days - 146096) / 146097;
+    int dayOfEra = days - era * 146097;
+    int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int mp = (5 * dayOfYear + 2) / 153;
+    
+    day = dayOfYear - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+}
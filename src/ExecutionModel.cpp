@@ -0,0 +1,93 @@
+// ExecutionModel.cpp
+#include "../include/ExecutionModel.h"
+#include <algorithm>
+#include <cmath>
+#include <climits>
+
+using namespace std;
+
+ExecutionModel::ExecutionModel() {
+    fixedCommission = 0.0;
+    percentCommission = 0.0;
+    slippageRate = 0.0;
+    impactRate = 0.0;
+    buyOrderType = ORDER_MARKET;
+    sellOrderType = ORDER_MARKET;
+    orderOffset = 0.0;
+    orderExpiryDays = 0;
+}
+
+void ExecutionModel::setCommission(double fixedPerTrade, double fractionOfValue) {
+    fixedCommission = fixedPerTrade;
+    percentCommission = fractionOfValue;
+}
+
+void ExecutionModel::setSlippage(double baseRate, double volumeImpact) {
+    slippageRate = baseRate;
+    impactRate = volumeImpact;
+}
+
+void ExecutionModel::setOrderTypes(OrderType buyType, OrderType sellType, double offset, int expiryDays) {
+    buyOrderType = buyType;
+    sellOrderType = sellType;
+    orderOffset = offset;
+    orderExpiryDays = expiryDays;
+}
+
+double ExecutionModel::commission(int shares, double price) const {
+    return fixedCommission + (percentCommission * shares * price);
+}
+
+// Slippage grows with the share of the bar's volume we take
+double ExecutionModel::slippedPrice(TradeSide side, double price, int shares, long long volume) const {
+    double participation = (volume > 0) ? (double)shares / volume : 0.0;
+    double slip = slippageRate + (impactRate * participation);
+    return (side == TRADE_BUY) ? price * (1.0 + slip) : price * (1.0 - slip);
+}
+
+// Sized with the slippage of the all-in order, which is never less than
+// the slippage of the (smaller) final order, so the result is affordable.
+// Share counts are capped at INT_MAX (huge cash / tiny prices).
+int ExecutionModel::affordableShares(double cash, double price, long long volume, bool withSlippage) const {
+    double budget = cash - fixedCommission;
+    if (budget <= 0 || price <= 0) return 0;
+    
+    double fillPrice = price;
+    if (withSlippage) {
+        int estimate = (int)min(floor(budget / price), (double)INT_MAX);
+        fillPrice = slippedPrice(TRADE_BUY, price, estimate, volume);
+    }
+    
+    double shares = floor(budget / (fillPrice * (1.0 + percentCommission)));
+    return (int)min(shares, (double)INT_MAX);
+}
+
+double ExecutionModel::triggerPrice(TradeSide side, double close) const {
+    OrderType type = getOrderType(side);
+    bool below = (side == TRADE_BUY) == (type == ORDER_LIMIT);
+    return below ? close * (1.0 - orderOffset) : close * (1.0 + orderOffset);
+}
+
+bool ExecutionModel::tryFill(TradeSide side, double trigger, double open, double high, double low, double& fillPrice) const {
+    OrderType type = getOrderType(side);
+    bool below = (side == TRADE_BUY) == (type == ORDER_LIMIT);
+    
+    if (below) {
+        // Buy limit / sell stop: price has to trade down to the trigger
+        if (low > trigger) return false;
+        fillPrice = min(open, trigger);
+    } else {
+        // Buy stop / sell limit: price has to trade up to the trigger
+        if (high < trigger) return false;
+        fillPrice = max(open, trigger);
+    }
+    return true;
+}
+
+OrderType ExecutionModel::getOrderType(TradeSide side) const {
+    return (side == TRADE_BUY) ? buyOrderType : sellOrderType;
+}
+
+int ExecutionModel::getOrderExpiryDays() const {
+    return orderExpiryDays;
+}
\ No newline at end of file
@@ -0,0 +1,262 @@
+// IndicatorRegistry.cpp
+#include "../include/IndicatorRegistry.h"
+#include <sstream>
+#include <algorithm>
+
+using namespace std;
+
+bool IndicatorKey::operator<(const IndicatorKey& other) const {
+    if (name != other.name) {
+        return name < other.name;
+    }
+    return params < other.params;
+}
+
+IndicatorEntry::IndicatorEntry(int period) : sum(period), variance(period), rsi(period) {
+    firstValid = 0;
+}
+
+// Constructor
+IndicatorRegistry::IndicatorRegistry() {}
+
+// Get a series, computing and caching it on first use
+const Series& IndicatorRegistry::get(const string& name, const vector<double>& params, const Series& closes,
+                                     string& message) {
+    // The middle Bollinger band is the SMA itself
+    if (name == "BB_MIDDLE") {
+        return get("SMA", params, closes, message);
+    }
+    
+    IndicatorKey key;
+    key.name = name;
+    key.params = params;
+    
+    {
+        lock_guard<mutex> guard(cacheMutex);
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            return it->second.values;
+        }
+    }
+    
+    // Compute without holding the lock so other series can be built in
+    // parallel. If two threads race on the same key the first insert wins.
+    IndicatorEntry entry(params.empty() ? 1 : (int)params[0]);
+    if (!compute(key, closes, entry, message)) {
+        return emptySeries;
+    }
+    entry.firstValid = warmup(key);
+    
+    lock_guard<mutex> guard(cacheMutex);
+    return cache.emplace(key, std::move(entry)).first->second.values;
+}
+
+bool IndicatorRegistry::has(const string& name, const vector<double>& params) const {
+    lock_guard<mutex> guard(cacheMutex);
+    IndicatorKey key;
+    key.name = name;
+    key.params = params;
+    return cache.find(key) != cache.end();
+}
+
+int IndicatorRegistry::firstValid(const string& name, const vector<double>& params) const {
+    IndicatorKey key;
+    key.name = (name == "BB_MIDDLE") ? "SMA" : name;
+    key.params = params;
+    
+    lock_guard<mutex> guard(cacheMutex);
+    auto it = cache.find(key);
+    return (it != cache.end()) ? it->second.firstValid : 0;
+}
+
+int IndicatorRegistry::size() const {
+    lock_guard<mutex> guard(cacheMutex);
+    return cache.size();
+}
+
+void IndicatorRegistry::clear() {
+    lock_guard<mutex> guard(cacheMutex);
+    cache.clear();
+}
+
+// Extend all series, inputs before the series built from them
+void IndicatorRegistry::extend(const Series& closes) {
+    string message;             // Cached keys were checked when first computed
+    for (int level = 0; level <= 3; level++) {
+        for (auto& pair : cache) {
+            if (dependencyLevel(pair.first.name) == level) {
+                compute(pair.first, closes, pair.second, message);
+            }
+        }
+    }
+}
+
+// Drop the oldest values of every series
+void IndicatorRegistry::eraseFront(int count) {
+    lock_guard<mutex> guard(cacheMutex);
+    for (auto& pair : cache) {
+        Series& values = pair.second.values;
+        values.erase(values.begin(), values.begin() + min(count, (int)values.size()));
+        pair.second.firstValid = max(0, pair.second.firstValid - count);
+    }
+}
+
+// Longest warm-up/look-back of the cached series (in bars)
+int IndicatorRegistry::lookback() const {
+    lock_guard<mutex> guard(cacheMutex);
+    int bars = 0;
+    for (const auto& pair : cache) {
+        const string& name = pair.first.name;
+        const vector<double>& p = pair.first.params;
+        if (p.empty()) continue;
+        
+        int needed = p[0];
+        if (name == "RSI") {
+            needed = p[0] + 1;              // Reads closes[i - period - 1]
+        } else if (name == "MACD") {
+            needed = max(p[0], p[1]);
+        } else if (name == "MACD_SIGNAL" || name == "MACD_HIST") {
+            needed = max(p[0], p[1]) + p[2];
+        }
+        bars = max(bars, needed);
+    }
+    return bars;
+}
+
+// Warm-up of each indicator, matching where compute() starts writing
+int IndicatorRegistry::warmup(const IndicatorKey& key) {
+    const string& name = key.name;
+    const vector<double>& p = key.params;
+    if (p.empty()) return 0;
+    
+    if (name == "RSI" || name == "MOMENTUM") {
+        return p[0];
+    } else if (name == "MACD") {
+        return max(p[0], p[1]) - 1;
+    } else if (name == "MACD_SIGNAL" || name == "MACD_HIST") {
+        return max(p[0], p[1]) - 1 + p[2] - 1;
+    }
+    return p[0] - 1;                        // SMA, EMA, STDDEV, Bollinger bands
+}
+
+// Helper: order in which series have to be extended
+int IndicatorRegistry::dependencyLevel(const string& name) {
+    if (name == "STDDEV" || name == "MACD") return 1;
+    if (name == "BB_UPPER" || name == "BB_LOWER" || name == "MACD_SIGNAL") return 2;
+    if (name == "MACD_HIST") return 3;
+    return 0;
+}
+
+// Helper: validate parameters (the first numPeriods must be whole periods >= 1)
+bool IndicatorRegistry::checkParams(const IndicatorKey& key, int count, int numPeriods, string& message) {
+    if ((int)key.params.size() != count) {
+        message = key.name + " expects " + to_string(count) + " parameter(s)";
+        return false;
+    }
+    
+    for (int i = 0; i < numPeriods; i++) {
+        double period = key.params[i];
+        if (period < 1 || period != (int)period) {
+            ostringstream text;
+            text << key.name << " period " << period << " not supported";
+            message = text.str();
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+// Compute (or extend) one series, reusing cached building blocks
+bool IndicatorRegistry::compute(const IndicatorKey& key, const Series& closes, IndicatorEntry& entry,
+                                string& message) {
+    const string& name = key.name;
+    const vector<double>& p = key.params;
+    const double* data = closes.data();
+    int n = closes.size();
+    Series& out = entry.values;
+    int start = out.size();
+    
+    if (name == "SMA") {
+        if (!checkParams(key, 1, 1, message)) return false;
+        Indicators::extendSMA(data, n, entry.sum, out);
+        
+    } else if (name == "EMA") {
+        if (!checkParams(key, 1, 1, message)) return false;
+        Indicators::extendEMA(data, n, p[0], out);
+        
+    } else if (name == "MOMENTUM") {
+        if (!checkParams(key, 1, 1, message)) return false;
+        Indicators::extendMomentum(data, n, p[0], out);
+        
+    } else if (name == "RSI") {
+        if (!checkParams(key, 1, 1, message)) return false;
+        Indicators::extendRSI(data, n, entry.rsi, out);
+        
+    } else if (name == "STDDEV") {
+        if (!checkParams(key, 1, 1, message)) return false;
+        const Series& mean = get("SMA", {p[0]}, closes, message);
+        Indicators::extendStdDev(data, mean.data(), n, entry.variance, out);
+        
+    } else if (name == "BB_UPPER" || name == "BB_LOWER") {
+        if (!checkParams(key, 2, 1, message)) return false;
+        const Series& mean = get("SMA", {p[0]}, closes, message);
+        const Series& stdDev = get("STDDEV", {p[0]}, closes, message);
+        double width = (name == "BB_UPPER") ? p[1] : -p[1];
+        
+        out.resize(n, 0.0);
+        for (int i = max(start, (int)p[0] - 1); i < n; i++) {
+            out[i] = mean[i] + (width * stdDev[i]);
+        }
+        
+    } else if (name == "MACD") {
+        if (!checkParams(key, 2, 2, message)) return false;
+        const Series& fast = get("EMA", {p[0]}, closes, message);
+        const Series& slow = get("EMA", {p[1]}, closes, message);
+        
+        // Defined once the slow EMA is
+        out.resize(n, 0.0);
+        for (int i = max(start, (int)p[1] - 1); i < n; i++) {
+            out[i] = fast[i] - slow[i];
+        }
+        
+    } else if (name == "MACD_SIGNAL") {
+        if (!checkParams(key, 3, 3, message)) return false;
+        const Series& macd = get("MACD", {p[0], p[1]}, closes, message);
+        int signalPeriod = p[2];
+        int first = (int)p[1] - 1 + signalPeriod - 1;
+        double multiplier = 2.0 / (signalPeriod + 1);
+        
+        out.resize(n, 0.0);
+        for (int i = max(start, first); i < n; i++) {
+            if (i == first) {
+                // First signal = SMA of MACD
+                double sum = 0.0;
+                for (int j = first - signalPeriod + 1; j <= first; j++) {
+                    sum += macd[j];
+                }
+                out[first] = sum / signalPeriod;
+            } else {
+                out[i] = (macd[i] * multiplier) + (out[i - 1] * (1 - multiplier));
+            }
+        }
+        
+    } else if (name == "MACD_HIST") {
+        if (!checkParams(key, 3, 3, message)) return false;
+        const Series& macd = get("MACD", {p[0], p[1]}, closes, message);
+        const Series& signal = get("MACD_SIGNAL", p, closes, message);
+        
+        out.resize(n, 0.0);
+        for (int i = start; i < n; i++) {
+            if (signal[i] != 0.0) {
+                out[i] = macd[i] - signal[i];
+            }
+        }
+        
+    } else {
+        message = "unknown indicator " + name;
+        return false;
+    }
+    
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,266 @@
+// Indicators.cpp
+#include "../include/Indicators.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// Re-sum at least every 1024 steps, but never more often than once per
+// window so the exact recomputation stays O(1) amortized.
+int Indicators::resumInterval(int period) {
+    return max(1024, period);
+}
+
+// Rolling sum
+RollingSum::RollingSum(int windowPeriod) {
+    period = windowPeriod;
+    resumInterval = Indicators::resumInterval(windowPeriod);
+    steps = 0;
+    sum = 0.0;
+}
+
+void RollingSum::add(const double* values, int i) {
+    if (i < period) {
+        sum += values[i];
+        return;
+    }
+    
+    if (++steps >= resumInterval) {
+        // Exact recomputation of the window
+        sum = 0.0;
+        for (int j = i - period + 1; j <= i; j++) {
+            sum += values[j];
+        }
+        steps = 0;
+    } else {
+        sum += values[i] - values[i - period];
+    }
+}
+
+// Rolling variance
+RollingVariance::RollingVariance(int windowPeriod) {
+    period = windowPeriod;
+    resumInterval = Indicators::resumInterval(windowPeriod);
+    steps = 0;
+    m2 = 0.0;
+}
+
+void RollingVariance::add(const double* values, const double* means, int i) {
+    if (i < period - 1) {
+        return;  // Window not full yet
+    }
+    
+    bool exact = (i == period - 1);
+    if (!exact && ++steps >= resumInterval) {
+        exact = true;
+        steps = 0;
+    }
+    
+    if (exact) {
+        m2 = 0.0;
+        for (int j = i - period + 1; j <= i; j++) {
+            double diff = values[j] - means[i];
+            m2 += diff * diff;
+        }
+    } else {
+        // Replace the oldest value with the newest one
+        double newValue = values[i];
+        double oldValue = values[i - period];
+        m2 += (newValue - oldValue) * (newValue - means[i] + oldValue - means[i - 1]);
+    }
+}
+
+double RollingVariance::variance() const {
+    return max(0.0, m2 / period);
+}
+
+// Rolling covariance
+RollingCovariance::RollingCovariance(int windowPeriod) {
+    period = windowPeriod;
+    resumInterval = Indicators::resumInterval(windowPeriod);
+    steps = 0;
+    c2 = 0.0;
+}
+
+void RollingCovariance::add(const double* x, const double* y, const double* meansX, const double* meansY, int i) {
+    if (i < period - 1) {
+        return;  // Window not full yet
+    }
+    
+    bool exact = (i == period - 1);
+    if (!exact && ++steps >= resumInterval) {
+        exact = true;
+        steps = 0;
+    }
+    
+    if (exact) {
+        c2 = 0.0;
+        for (int j = i - period + 1; j <= i; j++) {
+            c2 += (x[j] - meansX[i]) * (y[j] - meansY[i]);
+        }
+    } else {
+        // Replace the oldest pair with the newest one
+        int old = i - period;
+        c2 += (x[i] - x[old]) * (y[i] - meansY[i]) + (y[i] - y[old]) * (x[old] - meansX[i - 1]);
+    }
+}
+
+double RollingCovariance::covariance() const {
+    return c2 / period;
+}
+
+// Rolling RSI
+RollingRSI::RollingRSI(int windowPeriod) {
+    period = windowPeriod;
+    resumInterval = Indicators::resumInterval(windowPeriod);
+    steps = 0;
+    sumGain = 0.0;
+    sumLoss = 0.0;
+    lossCount = 0;
+}
+
+void RollingRSI::add(const double* closes, int i) {
+    double change = closes[i] - closes[i - 1];
+    
+    if (change < 0) lossCount++;
+    
+    if (i <= period) {
+        if (change > 0) sumGain += change;
+        else sumLoss -= change;
+        return;
+    }
+    
+    double oldChange = closes[i - period] - closes[i - period - 1];
+    if (oldChange < 0) lossCount--;
+    
+    if (++steps >= resumInterval) {
+        sumGain = 0.0;
+        sumLoss = 0.0;
+        for (int j = i - period + 1; j <= i; j++) {
+            double c = closes[j] - closes[j - 1];
+            if (c > 0) sumGain += c;
+            else sumLoss -= c;
+        }
+        steps = 0;
+    } else {
+        if (change > 0) sumGain += change;
+        else sumLoss -= change;
+        if (oldChange > 0) sumGain -= oldChange;
+        else sumLoss += oldChange;
+    }
+}
+
+double RollingRSI::value() const {
+    if (lossCount == 0) {
+        return 100.0;
+    }
+    
+    double avgGain = max(0.0, sumGain) / period;
+    double avgLoss = sumLoss / period;
+    double rs = avgGain / avgLoss;
+    return 100.0 - (100.0 / (1.0 + rs));
+}
+
+// Simple Moving Average
+void Indicators::sma(const double* values, int n, int period, Series& out) {
+    RollingSum window(period);
+    out.clear();
+    extendSMA(values, n, window, out);
+}
+
+void Indicators::extendSMA(const double* values, int n, RollingSum& window, Series& out) {
+    int start = out.size();
+    if (start >= n) return;
+    out.resize(n, 0.0);
+    
+    int period = window.period;
+    for (int i = start; i < n; i++) {
+        window.add(values, i);
+        if (i >= period - 1) {
+            out[i] = window.sum / period;
+        }
+    }
+}
+
+// Exponential Moving Average (seeded with the SMA of the first window)
+void Indicators::ema(const double* values, int n, int period, Series& out) {
+    out.clear();
+    extendEMA(values, n, period, out);
+}
+
+void Indicators::extendEMA(const double* values, int n, int period, Series& out) {
+    int start = out.size();
+    if (start >= n) return;
+    out.resize(n, 0.0);
+    if (n < period) return;
+    
+    double multiplier = 2.0 / (period + 1);
+    
+    if (start <= period - 1) {
+        double sum = 0.0;
+        for (int j = 0; j < period; j++) {
+            sum += values[j];
+        }
+        out[period - 1] = sum / period;
+        start = period;
+    }
+    
+    for (int i = start; i < n; i++) {
+        out[i] = (values[i] * multiplier) + (out[i - 1] * (1 - multiplier));
+    }
+}
+
+// Rolling population standard deviation around the given means
+void Indicators::stdDev(const double* values, const double* means, int n, int period, Series& out) {
+    RollingVariance window(period);
+    out.clear();
+    extendStdDev(values, means, n, window, out);
+}
+
+void Indicators::extendStdDev(const double* values, const double* means, int n, RollingVariance& window, Series& out) {
+    int start = out.size();
+    if (start >= n) return;
+    out.resize(n, 0.0);
+    
+    for (int i = max(start, window.period - 1); i < n; i++) {
+        window.add(values, means, i);
+        out[i] = sqrt(window.variance());
+    }
+}
+
+// Relative Strength Index (simple average of gains/losses)
+void Indicators::rsi(const double* closes, int n, int period, Series& out) {
+    RollingRSI window(period);
+    out.clear();
+    extendRSI(closes, n, window, out);
+}
+
+void Indicators::extendRSI(const double* closes, int n, RollingRSI& window, Series& out) {
+    int start = out.size();
+    if (start >= n) return;
+    out.resize(n, 0.0);
+    
+    for (int i = max(start, 1); i < n; i++) {
+        window.add(closes, i);
+        if (i >= window.period) {
+            out[i] = window.value();
+        }
+    }
+}
+
+// Percentage change over `period` days
+void Indicators::momentum(const double* closes, int n, int period, Series& out) {
+    out.clear();
+    extendMomentum(closes, n, period, out);
+}
+
+void Indicators::extendMomentum(const double* closes, int n, int period, Series& out) {
+    int start = out.size();
+    if (start >= n) return;
+    out.resize(n, 0.0);
+    
+    for (int i = max(start, period); i < n; i++) {
+        double oldPrice = closes[i - period];
+        out[i] = ((closes[i] - oldPrice) / oldPrice) * 100.0;
+    }
+}
\ No newline at end of file
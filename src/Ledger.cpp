@@ -0,0 +1,115 @@
+// Ledger.cpp
+#include "../include/Ledger.h"
+#include "../include/DateUtil.h"
+#include <algorithm>
+
+using namespace std;
+
+// Constructor
+Ledger::Ledger() {
+    datesSorted = true;
+}
+
+int Ledger::add(const string& symbol, TradeSide side, int quantity, double price, int date) {
+    int id = SymbolTable::global().intern(symbol);
+    int row = symbolIds.size();
+    
+    if (!dates.empty() && date < dates.back()) {
+        datesSorted = false;
+    }
+    
+    symbolIds.push_back(id);
+    sides.push_back(side);
+    quantities.push_back(quantity);
+    prices.push_back(price);
+    dates.push_back(date);
+    
+    if (id >= (int)rowsBySymbol.size()) {
+        rowsBySymbol.resize(id + 1);
+    }
+    rowsBySymbol[id].push_back(row);
+    
+    return row;
+}
+
+void Ledger::reserve(size_t rows) {
+    symbolIds.reserve(rows);
+    sides.reserve(rows);
+    quantities.reserve(rows);
+    prices.reserve(rows);
+    dates.reserve(rows);
+}
+
+void Ledger::clear() {
+    symbolIds.clear();
+    sides.clear();
+    quantities.clear();
+    prices.clear();
+    dates.clear();
+    rowsBySymbol.clear();
+    datesSorted = true;
+}
+
+const vector<int>& Ledger::rowsForSymbol(const string& symbol) const {
+    return rowsForSymbol(SymbolTable::global().find(symbol));
+}
+
+const vector<int>& Ledger::rowsForSymbol(int symbolId) const {
+    static const vector<int> none;
+    return (symbolId >= 0 && symbolId < (int)rowsBySymbol.size()) ? rowsBySymbol[symbolId] : none;
+}
+
+// With rows in date order the range is found by binary search,
+// otherwise every row of the list is checked
+void Ledger::filterByDate(const vector<int>& rows, int fromDate, int toDate, vector<int>& out) const {
+    if (datesSorted) {
+        auto first = lower_bound(rows.begin(), rows.end(), fromDate,
+                                 [this](int row, int date) { return dates[row] < date; });
+        auto last = upper_bound(first, rows.end(), toDate,
+                                [this](int date, int row) { return date < dates[row]; });
+        out.assign(first, last);
+        return;
+    }
+    
+    out.clear();
+    for (int row : rows) {
+        if (dates[row] >= fromDate && dates[row] <= toDate) {
+            out.push_back(row);
+        }
+    }
+}
+
+// Ids that never traded here (or -1 from find()) give no rows
+void Ledger::query(int symbolId, int fromDate, int toDate, vector<int>& out) const {
+    filterByDate(rowsForSymbol(symbolId), fromDate, toDate, out);
+}
+
+vector<int> Ledger::query(const string& symbol, int fromDate, int toDate) const {
+    vector<int> result;
+    
+    if (!symbol.empty()) {
+        filterByDate(rowsForSymbol(symbol), fromDate, toDate, result);
+        return result;
+    }
+    
+    if (datesSorted) {
+        int first = lower_bound(dates.begin(), dates.end(), fromDate) - dates.begin();
+        int last = upper_bound(dates.begin(), dates.end(), toDate) - dates.begin();
+        for (int row = first; row < last; row++) {
+            result.push_back(row);
+        }
+        return result;
+    }
+    
+    for (int row = 0; row < size(); row++) {
+        if (dates[row] >= fromDate && dates[row] <= toDate) {
+            result.push_back(row);
+        }
+    }
+    return result;
+}
+
+string Ledger::format(int row) const {
+    return string(tradeSideName(sides[row])) + " " + to_string(quantities[row]) + " " + getSymbol(row) +
+           " @ $" + to_string(prices[row]) + " on " + DateUtil::formatDate(dates[row]);
+}
\ No newline at end of file
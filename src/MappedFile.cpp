@@ -0,0 +1,81 @@
+// MappedFile.cpp
+#include "../include/MappedFile.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Constructor
+MappedFile::MappedFile() {
+    data = nullptr;
+    length = 0;
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+// Map the whole file into memory
+bool MappedFile::open(const string& filename) {
+    close();
+    
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    
+    // Empty files can't be mapped but are still valid
+    if (info.st_size == 0) {
+        ::close(fd);
+        data = "";
+        length = 0;
+        return true;
+    }
+    
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // Mapping stays valid after closing the descriptor
+    
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    
+    // We read the file front to back once
+    madvise(mapped, info.st_size, MADV_SEQUENTIAL);
+    
+    data = static_cast<const char*>(mapped);
+    length = info.st_size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (data != nullptr && length > 0) {
+        munmap(const_cast<char*>(data), length);
+    }
+    data = nullptr;
+    length = 0;
+}
+
+// Getters
+const char* MappedFile::begin() const {
+    return data;
+}
+
+const char* MappedFile::end() const {
+    return data + length;
+}
+
+size_t MappedFile::size() const {
+    return length;
+}
+
+bool MappedFile::isOpen() const {
+    return data != nullptr;
+}
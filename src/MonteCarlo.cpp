@@ -0,0 +1,198 @@
+// MonteCarlo.cpp
+#include "../include/MonteCarlo.h"
+#include "../include/Backtester.h"
+#include "../include/Analytics.h"
+#include "../include/ThreadPool.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+MonteCarloConfig::MonteCarloConfig() {
+    numPaths = 1000;
+    pathLength = 0;
+    blockSize = 20;
+    seed = 42;
+    initialCash = 10000.0;
+    numThreads = 0;
+    execution = nullptr;
+}
+
+// Helper: SplitMix64 finalizer (full avalanche on 64 bits)
+static uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+uint64_t MonteCarlo::counterRandom(uint64_t seed, uint64_t stream, uint64_t counter) {
+    uint64_t key = mix64(seed ^ mix64(stream + 0x9E3779B97F4A7C15ULL));
+    return mix64(key + (counter + 1) * 0x9E3779B97F4A7C15ULL);
+}
+
+// Helper: percentile by linear interpolation on sorted values
+static double percentile(const vector<double>& sorted, double fraction) {
+    double position = fraction * (sorted.size() - 1);
+    size_t lower = (size_t)position;
+    size_t upper = min(lower + 1, sorted.size() - 1);
+    double weight = position - lower;
+    return sorted[lower] * (1.0 - weight) + sorted[upper] * weight;
+}
+
+Distribution MonteCarlo::summarize(vector<double> values) {
+    Distribution d = {0.0, 0.0, 0.0, 0.0};
+    if (values.empty()) return d;
+    
+    sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (double v : values) {
+        sum += v;
+    }
+    d.mean = sum / values.size();
+    d.p5 = percentile(values, 0.05);
+    d.p50 = percentile(values, 0.50);
+    d.p95 = percentile(values, 0.95);
+    return d;
+}
+
+MonteCarloResult MonteCarlo::run(Stock* stock, StrategyFactory factory, const ParameterSet& params,
+                                 const MonteCarloConfig& config) {
+    MonteCarloResult result;
+    result.paths.assign(max(0, config.numPaths), MonteCarloPath{0.0, 0.0, 0.0});
+    result.historicalReturn = 0.0;
+    result.historicalDrawdown = 0.0;
+    result.historicalSharpe = 0.0;
+    
+    // Daily returns (in percent) as growth factors, so a path is just
+    // a running product of resampled factors
+    vector<double> growth = Analytics::calculateDailyReturns(stock);
+    int numReturns = growth.size();
+    for (double& g : growth) {
+        g = 1.0 + g / 100.0;
+    }
+    Strategy* reference = factory(params);
+    if (numReturns == 0 || reference == nullptr) {
+        delete reference;
+        return result;
+    }
+    
+    // Strategy on the real data
+    Backtester historical(stock, reference, config.initialCash);
+    historical.setExecutionModel(config.execution);
+    historical.run(false);
+    result.historicalReturn = historical.getTotalReturn();
+    result.historicalDrawdown = historical.getMaxDrawdown();
+    result.historicalSharpe = historical.getSharpeRatio();
+    delete reference;
+    
+    // Paths start at the first close and use the average volume (no
+    // intraday range is simulated: open = high = low = close)
+    const BarStore& bars = stock->getBars();
+    double startPrice = bars.getClose(0);
+    int startDate = bars.getDate(0);
+    long long totalVolume = 0;
+    for (int i = 0; i < bars.size(); i++) {
+        totalVolume += bars.getVolume(i);
+    }
+    long long averageVolume = totalVolume / bars.size();
+    
+    int pathLength = (config.pathLength > 0) ? config.pathLength : numReturns;
+    int blockSize = max(1, min(config.blockSize, numReturns));
+    int numStarts = numReturns - blockSize + 1;
+    int numBlocks = (pathLength + blockSize - 1) / blockSize;
+    int numBars = pathLength + 1;
+    
+    // Columns that are the same for every path
+    AlignedVector<int> dates(numBars);
+    AlignedVector<long long> volumes(numBars, averageVolume);
+    for (int i = 0; i < numBars; i++) {
+        dates[i] = startDate + i;
+    }
+    
+    {
+        ThreadPool pool(config.numThreads);
+        
+        const int batchSize = 16;
+        for (int first = 0; first < config.numPaths; first += batchSize) {
+            int last = min(first + batchSize, config.numPaths);
+            
+            pool.submit([&, first, last] {
+                // Scratch space reused by every path in the batch
+                Series pathGrowth(numBlocks * blockSize);
+                Series closes(numBars);
+                BarStore block;
+                
+                for (int p = first; p < last; p++) {
+                    // Concatenate random blocks of historical growth factors
+                    for (int k = 0; k < numBlocks; k++) {
+                        int start = counterRandom(config.seed, p, k) % numStarts;
+                        memcpy(&pathGrowth[k * blockSize], &growth[start], blockSize * sizeof(double));
+                    }
+                    
+                    // Compound into prices
+                    closes[0] = startPrice;
+                    for (int i = 0; i < pathLength; i++) {
+                        closes[i + 1] = closes[i] * pathGrowth[i];
+                    }
+                    
+                    block.clear();
+                    block.append(dates.data(), closes.data(), closes.data(), closes.data(),
+                                 closes.data(), volumes.data(), numBars);
+                    
+                    Stock path(stock->getSymbol(), stock->getName());
+                    path.appendBars(block);
+                    
+                    Strategy* strategy = factory(params);
+                    Backtester backtester(&path, strategy, config.initialCash);
+                    backtester.setExecutionModel(config.execution);
+                    backtester.run(false);
+                    
+                    MonteCarloPath& outcome = result.paths[p];
+                    outcome.totalReturn = backtester.getTotalReturn();
+                    outcome.maxDrawdown = backtester.getMaxDrawdown();
+                    outcome.sharpeRatio = backtester.getSharpeRatio();
+                    
+                    delete strategy;
+                }
+            });
+        }
+        
+        pool.waitAll();
+    }
+    
+    // Distributions over all paths
+    vector<double> values(result.paths.size());
+    for (size_t i = 0; i < values.size(); i++) values[i] = result.paths[i].totalReturn;
+    result.returns = summarize(values);
+    for (size_t i = 0; i < values.size(); i++) values[i] = result.paths[i].maxDrawdown;
+    result.drawdowns = summarize(values);
+    for (size_t i = 0; i < values.size(); i++) values[i] = result.paths[i].sharpeRatio;
+    result.sharpeRatios = summarize(values);
+    
+    return result;
+}
+
+void MonteCarlo::displayResults(const MonteCarloResult& result) {
+    cout << "\n========================================" << endl;
+    cout << "    MONTE CARLO RESULTS" << endl;
+    cout << "========================================" << endl;
+    cout << "Paths: " << result.paths.size() << endl;
+    
+    if (result.paths.empty()) return;
+    
+    cout << fixed << setprecision(2);
+    cout << "\n\t\tHistory\t5%\t50%\t95%\tMean" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Return (%)\t" << result.historicalReturn << "\t" << result.returns.p5 << "\t"
+         << result.returns.p50 << "\t" << result.returns.p95 << "\t" << result.returns.mean << endl;
+    cout << "Max DD (%)\t" << result.historicalDrawdown << "\t" << result.drawdowns.p5 << "\t"
+         << result.drawdowns.p50 << "\t" << result.drawdowns.p95 << "\t" << result.drawdowns.mean << endl;
+    cout << "Sharpe\t\t" << result.historicalSharpe << "\t" << result.sharpeRatios.p5 << "\t"
+         << result.sharpeRatios.p50 << "\t" << result.sharpeRatios.p95 << "\t" << result.sharpeRatios.mean << endl;
+    cout << "========================================" << endl;
+}
\ No newline at end of file
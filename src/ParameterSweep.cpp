@@ -0,0 +1,181 @@
+// ParameterSweep.cpp
+#include "../include/ParameterSweep.h"
+#include "../include/Backtester.h"
+#include "../include/ThreadPool.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <climits>
+
+using namespace std;
+
+// ===== ParameterGrid =====
+
+void ParameterGrid::add(const string& name, const vector<double>& paramValues) {
+    names.push_back(name);
+    values.push_back(paramValues);
+}
+
+void ParameterGrid::addRange(const string& name, double from, double to, double step) {
+    vector<double> range;
+    if (step > 0) {
+        // Small tolerance so e.g. 0.1 steps still reach the end point
+        for (double v = from; v <= to + step * 1e-9; v += step) {
+            range.push_back(v);
+        }
+    }
+    add(name, range);
+}
+
+long long ParameterGrid::size() const {
+    if (values.empty()) return 0;
+    
+    long long combinations = 1;
+    for (const vector<double>& v : values) {
+        combinations *= v.size();
+    }
+    return combinations;
+}
+
+// Decode index as a mixed-radix number (last parameter varies fastest)
+ParameterSet ParameterGrid::at(long long index) const {
+    ParameterSet params;
+    for (int i = values.size() - 1; i >= 0; i--) {
+        long long count = values[i].size();
+        params[names[i]] = values[i][index % count];
+        index /= count;
+    }
+    return params;
+}
+
+// ===== ParameterSweep =====
+
+vector<SweepResult> ParameterSweep::run(Stock* stock, const ParameterGrid& grid, StrategyFactory factory,
+                                        double initialCash, int numThreads,
+                                        const ExecutionModel* execution) {
+    long long combinations = grid.size();
+    vector<SweepResult> results(combinations);
+    
+    {
+        ThreadPool pool(numThreads);
+        
+        // Small batches keep task overhead low; stealing balances the rest
+        const long long batchSize = 16;
+        for (long long first = 0; first < combinations; first += batchSize) {
+            long long last = min(first + batchSize, combinations);
+            
+            pool.submit([&, first, last] {
+                // One backtester per batch so its recording storage is reused
+                Backtester backtester(stock, nullptr, initialCash);
+                backtester.setExecutionModel(execution);
+                
+                for (long long i = first; i < last; i++) {
+                    SweepResult& result = results[i];
+                    result.params = grid.at(i);
+                    
+                    Strategy* strategy = factory(result.params);
+                    result.valid = (strategy != nullptr);
+                    if (!result.valid) continue;
+                    
+                    backtester.setStrategy(strategy);
+                    backtester.run(false);
+                    
+                    result.totalReturn = backtester.getTotalReturn();
+                    result.finalValue = backtester.getFinalValue();
+                    result.maxDrawdown = backtester.getMaxDrawdown();
+                    result.numTrades = backtester.getNumTrades();
+                    result.winningTrades = backtester.getWinningTrades();
+                    
+                    delete strategy;
+                }
+            });
+        }
+        
+        pool.waitAll();
+    }
+    
+    // Drop combinations the factory rejected
+    results.erase(remove_if(results.begin(), results.end(),
+                            [](const SweepResult& r) { return !r.valid; }),
+                  results.end());
+    if (combinations > 0 && results.empty()) {
+        cout << "Error: no parameter combination gave a strategy (check the grid's parameter names)" << endl;
+    }
+    
+    // Rank by return (ties keep grid order)
+    stable_sort(results.begin(), results.end(), [](const SweepResult& a, const SweepResult& b) {
+        return a.totalReturn > b.totalReturn;
+    });
+    
+    return results;
+}
+
+void ParameterSweep::displayResults(const vector<SweepResult>& results, int top) {
+    cout << "\n========================================" << endl;
+    cout << "    PARAMETER SWEEP RESULTS" << endl;
+    cout << "========================================" << endl;
+    cout << "Combinations tested: " << results.size() << endl;
+    
+    if (results.empty()) return;
+    
+    cout << fixed << setprecision(2);
+    cout << "\nRank\tReturn\t\tMax DD\t\tTrades\tParameters" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    
+    int shown = min(top, (int)results.size());
+    for (int i = 0; i < shown; i++) {
+        const SweepResult& r = results[i];
+        cout << i + 1 << "\t" << r.totalReturn << "%\t\t" << r.maxDrawdown << "%\t\t" << r.numTrades << "\t";
+        
+        for (const auto& param : r.params) {
+            cout << param.first << "=" << param.second << " ";
+        }
+        cout << endl;
+    }
+    
+    cout << "========================================" << endl;
+}
+
+// Helper: value of a named parameter, false if the set doesn't have it
+static bool lookup(const ParameterSet& params, const string& name, double& value) {
+    auto it = params.find(name);
+    if (it == params.end()) return false;
+    value = it->second;
+    return true;
+}
+
+// Helper: a named parameter that must be a whole number of bars (>= 1)
+static bool lookupPeriod(const ParameterSet& params, const string& name, int& period) {
+    double value;
+    if (!lookup(params, name, value)) return false;
+    
+    // Small tolerance for values built up by addRange steps
+    double rounded = round(value);
+    if (fabs(value - rounded) > 1e-9 || rounded < 1 || rounded > INT_MAX) return false;
+    period = (int)rounded;
+    return true;
+}
+
+StrategyFactory ParameterSweep::rsiFactory() {
+    return [](const ParameterSet& p) -> Strategy* {
+        int period;
+        double oversold, overbought;
+        if (!lookupPeriod(p, "period", period) || !lookup(p, "oversold", oversold) ||
+            !lookup(p, "overbought", overbought)) {
+            return nullptr;
+        }
+        return new RSIStrategy(period, oversold, overbought);
+    };
+}
+
+StrategyFactory ParameterSweep::maFactory() {
+    return [](const ParameterSet& p) -> Strategy* {
+        int fast, slow;
+        if (!lookupPeriod(p, "fast", fast) || !lookupPeriod(p, "slow", slow)) return nullptr;
+        
+        // A "fast" average must be shorter than the slow one
+        if (fast >= slow) return nullptr;
+        return new MAStrategy(fast, slow);
+    };
+}
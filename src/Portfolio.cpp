@@ -1,18 +1,34 @@
 // Portfolio.cpp
 #include "../include/Portfolio.h"
+#include "../include/MappedFile.h"
+#include "../include/DateUtil.h"
+#include "../include/ValuationEngine.h"
 #include <iostream>
 #include <iomanip>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <unistd.h>
 
 using namespace std;
 
 // Constructor
-Portfolio::Portfolio(string portfolioName) {
+Portfolio::Portfolio(const string& portfolioName) {
     name = portfolioName;
     cashBalance = 0.0;
+    realizedPnL = 0.0;
+    generation = 0;
 }
 
 // Buy stock
-void Portfolio::buyStock(string symbol, int quantity, double price, string date) {
+void Portfolio::buyStock(const string& symbol, int quantity, double price, const string& date) {
+    int day;
+    if (!DateUtil::parseDate(date, day)) {
+        cout << "Error: Invalid date '" << date << "' (use YYYY-MM-DD)" << endl;
+        return;
+    }
+    
     double totalCost = quantity * price;
     
     // Check if enough cash
@@ -22,13 +38,61 @@ void Portfolio::buyStock(string symbol, int quantity, double price, string date)
         return;
     }
     
+    applyBuy(symbol, quantity, price, day);
+    logChange(JOURNAL_BUY, symbol, quantity, price, day);
+    
+    cout << "✓ Bought " << quantity << " shares of " << symbol << endl;
+}
+
+// Sell stock
+void Portfolio::sellStock(const string& symbol, int quantity, double price, const string& date) {
+    int day;
+    if (!DateUtil::parseDate(date, day)) {
+        cout << "Error: Invalid date '" << date << "' (use YYYY-MM-DD)" << endl;
+        return;
+    }
+    
+    // Check if we own this stock
+    int slot = findHolding(symbol);
+    if (slot < 0) {
+        cout << "Error: You don't own " << symbol << endl;
+        return;
+    }
+    
+    const Holding& h = holdings[slot];
+    
+    // Check if enough quantity
+    if (h.quantity < quantity) {
+        cout << "Error: You only have " << h.quantity << " shares of " << symbol << endl;
+        return;
+    }
+    
+    applySell(symbol, quantity, price, day);
+    logChange(JOURNAL_SELL, symbol, quantity, price, day);
+    
+    cout << "✓ Sold " << quantity << " shares of " << symbol << endl;
+}
+
+// Apply changes
+void Portfolio::applyCash(double amount) {
+    cashBalance += amount;
+}
+
+void Portfolio::applyBuy(const string& symbol, int quantity, double price, int date) {
+    double totalCost = quantity * price;
+    
     // Deduct cash
     cashBalance -= totalCost;
     
     // Add or update holding
-    if (holdings.find(symbol) != holdings.end()) {
+    int id = SymbolTable::global().intern(symbol);
+    if (id >= (int)holdingSlots.size()) {
+        holdingSlots.resize(id + 1, -1);
+    }
+    
+    if (holdingSlots[id] >= 0) {
         // Already own this stock - update average cost
-        Holding& h = holdings[symbol];
+        Holding& h = holdings[holdingSlots[id]];
         double totalValue = (h.quantity * h.avgCost) + totalCost;
         h.quantity += quantity;
         h.avgCost = totalValue / h.quantity;
@@ -36,58 +100,78 @@ void Portfolio::buyStock(string symbol, int quantity, double price, string date)
         // New stock
         Holding h;
         h.symbol = symbol;
+        h.symbolId = id;
         h.quantity = quantity;
         h.avgCost = price;
-        h.purchaseDate = date;
-        holdings[symbol] = h;
+        h.purchaseDate = DateUtil::formatDate(date);
+        holdingSlots[id] = holdings.size();
+        holdings.push_back(h);
     }
     
     // Record transaction
-    string transaction = "BUY " + to_string(quantity) + " " + symbol + 
-                        " @ $" + to_string(price) + " on " + date;
-    transactions.push_back(transaction);
-    
-    cout << "✓ Bought " << quantity << " shares of " << symbol << endl;
+    ledger.add(symbol, TRADE_BUY, quantity, price, date);
 }
 
-// Sell stock
-void Portfolio::sellStock(string symbol, int quantity, double price, string date) {
-    // Check if we own this stock
-    if (holdings.find(symbol) == holdings.end()) {
-        cout << "Error: You don't own " << symbol << endl;
-        return;
-    }
-    
-    Holding& h = holdings[symbol];
-    
-    // Check if enough quantity
-    if (h.quantity < quantity) {
-        cout << "Error: You only have " << h.quantity << " shares of " << symbol << endl;
-        return;
-    }
+void Portfolio::applySell(const string& symbol, int quantity, double price, int date) {
+    int slot = findHolding(symbol);
+    if (slot < 0) return;
     
     // Add cash from sale
     double revenue = quantity * price;
     cashBalance += revenue;
     
     // Update holding
+    Holding& h = holdings[slot];
+    realizedPnL += quantity * (price - h.avgCost);
     h.quantity -= quantity;
     
-    // Remove if quantity is 0
+    // Remove if quantity is 0 (the last holding moves into its slot)
     if (h.quantity == 0) {
-        holdings.erase(symbol);
+        holdingSlots[h.symbolId] = -1;
+        if (slot != (int)holdings.size() - 1) {
+            holdings[slot] = holdings.back();
+            holdingSlots[holdings[slot].symbolId] = slot;
+        }
+        holdings.pop_back();
     }
     
     // Record transaction
-    string transaction = "SELL " + to_string(quantity) + " " + symbol + 
-                        " @ $" + to_string(price) + " on " + date;
-    transactions.push_back(transaction);
+    ledger.add(symbol, TRADE_SELL, quantity, price, date);
+}
+
+void Portfolio::logChange(JournalType type, const string& symbol, int quantity, double amount, int date) {
+    if (!journal.isOpen()) return;
     
-    cout << "✓ Sold " << quantity << " shares of " << symbol << endl;
+    JournalRecord record = {type, symbol, quantity, amount, date};
+    if (!journal.append(record)) {
+        cout << "Error: Could not write to the journal of '" << snapshotFile << "'" << endl;
+    }
+}
+
+int Portfolio::findHolding(const string& symbol) const {
+    int id = SymbolTable::global().find(symbol);
+    return (id >= 0 && id < (int)holdingSlots.size()) ? holdingSlots[id] : -1;
+}
+
+void Portfolio::indexHoldings() {
+    holdingSlots.assign(SymbolTable::global().size(), -1);
+    for (size_t i = 0; i < holdings.size(); i++) {
+        holdingSlots[holdings[i].symbolId] = i;
+    }
+}
+
+vector<int> Portfolio::holdingsBySymbol() const {
+    vector<int> order(holdings.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    sort(order.begin(), order.end(),
+         [this](int a, int b) { return holdings[a].symbol < holdings[b].symbol; });
+    return order;
 }
 
 // Getters
-string Portfolio::getName() const {
+const string& Portfolio::getName() const {
     return name;
 }
 
@@ -96,7 +180,8 @@ double Portfolio::getCashBalance() const {
 }
 
 void Portfolio::addCash(double amount) {
-    cashBalance += amount;
+    applyCash(amount);
+    logChange(JOURNAL_CASH, "", 0, amount, 0);
     cout << "✓ Added $" << amount << " to portfolio" << endl;
 }
 
@@ -113,8 +198,8 @@ void Portfolio::displayHoldings() const {
     cout << "\nSymbol\tQuantity\tAvg Cost\tTotal Cost" << endl;
     cout << "------------------------------------------------" << endl;
     
-    for (const auto& pair : holdings) {
-        const Holding& h = pair.second;
+    for (int slot : holdingsBySymbol()) {
+        const Holding& h = holdings[slot];
         double totalCost = h.quantity * h.avgCost;
         
         cout << h.symbol << "\t" 
@@ -130,75 +215,360 @@ void Portfolio::displayHoldings() const {
 void Portfolio::displayTransactions() const {
     cout << "\n=== Transaction History ===" << endl;
     
-    if (transactions.empty()) {
+    if (ledger.empty()) {
         cout << "No transactions yet." << endl;
         return;
     }
     
-    for (int i = 0; i < transactions.size(); i++) {
-        cout << i + 1 << ". " << transactions[i] << endl;
+    for (int i = 0; i < ledger.size(); i++) {
+        cout << i + 1 << ". " << ledger.format(i) << endl;
+    }
+}
+
+void Portfolio::displayTransactions(const string& symbol, int fromDate, int toDate) const {
+    cout << "\n=== Transaction History ===" << endl;
+    
+    vector<int> rows = ledger.query(symbol, fromDate, toDate);
+    if (rows.empty()) {
+        cout << "No matching transactions." << endl;
+        return;
+    }
+    
+    for (int row : rows) {
+        cout << row + 1 << ". " << ledger.format(row) << endl;
     }
 }
 
 // Display summary with current values
-void Portfolio::displaySummary(const map<string, Stock*>& stockData) const {
+void Portfolio::displaySummary(const StockRegistry& stockData) const {
     cout << "\n=== Portfolio Summary: '" << name << "' ===" << endl;
     
     if (holdings.empty()) {
         cout << "No holdings yet." << endl;
         cout << "Cash Balance: $" << fixed << setprecision(2) << cashBalance << endl;
+        cout << "Realized P/L: $" << realizedPnL << endl;
         return;
     }
     
-    cout << fixed << setprecision(2);
-    cout << "\nSymbol\tQty\tAvg Cost\tCurrent\t\tProfit/Loss" << endl;
-    cout << "------------------------------------------------------------" << endl;
+    // Mark to the latest loaded closes
+    ValuationEngine engine;
+    engine.updatePrices(stockData);
+    engine.setPortfolios(vector<Portfolio*>(1, const_cast<Portfolio*>(this)));
+    engine.revalue();
+    const Valuation& value = engine.getValuation(0);
     
-    double totalValue = 0.0;
-    double totalCost = 0.0;
+    cout << fixed << setprecision(2);
+    cout << "\nSymbol\tQty\tAvg Cost\tCurrent\t\tValue\t\tProfit/Loss\tWeight" << endl;
+    cout << "----------------------------------------------------------------------------------------" << endl;
     
-    for (const auto& pair : holdings) {
-        const Holding& h = pair.second;
-        double costBasis = h.quantity * h.avgCost;
-        totalCost += costBasis;
+    for (int k : holdingsBySymbol()) {
+        const Holding& h = holdings[k];
+        double price = engine.getPrice(0, k);
+        double marketValue = engine.getMarketValue(0, k);
+        double weight = (value.totalValue != 0.0) ? marketValue / value.totalValue * 100.0 : 0.0;
         
-        // Get current price if stock data available
-        if (stockData.find(h.symbol) != stockData.end()) {
-            // For now, we'll add a method to get latest price later
-            cout << h.symbol << "\t" << h.quantity << "\t$" << h.avgCost 
-                 << "\t\t(Load stock data)" << "\t$0.00" << endl;
+        cout << h.symbol << "\t" << h.quantity << "\t$" << h.avgCost << "\t\t";
+        if (price > 0.0) {
+            double costBasis = h.quantity * h.avgCost;
+            double pnl = marketValue - costBasis;
+            double pnlPercent = (costBasis != 0.0) ? pnl / costBasis * 100.0 : 0.0;
+            cout << "$" << price << "\t\t$" << marketValue << "\t$" << pnl
+                 << " (" << pnlPercent << "%)\t" << weight << "%" << endl;
         } else {
-            cout << h.symbol << "\t" << h.quantity << "\t$" << h.avgCost 
-                 << "\t\tN/A\t\tN/A" << endl;
+            cout << "N/A\t\t$" << marketValue << " (cost)\tN/A\t\t" << weight << "%" << endl;
         }
     }
     
-    cout << "\nTotal Cost Basis: $" << totalCost << endl;
+    cout << "\nTotal Cost Basis: $" << value.costBasis << endl;
+    cout << "Market Value: $" << value.marketValue << endl;
+    cout << "Unrealized P/L: $" << value.unrealizedPnL << endl;
+    cout << "Realized P/L: $" << value.realizedPnL << endl;
     cout << "Cash Balance: $" << cashBalance << endl;
-    cout << "Total Portfolio Value: $" << (totalCost + cashBalance) << endl;
+    cout << "Total Portfolio Value: $" << value.totalValue << endl;
+    if (value.unpricedHoldings > 0) {
+        cout << "(" << value.unpricedHoldings << " holding(s) without loaded prices are valued at cost)" << endl;
+    }
 }
 
 // Check functions
-bool Portfolio::hasStock(string symbol) const {
-    return holdings.find(symbol) != holdings.end();
+bool Portfolio::hasStock(const string& symbol) const {
+    return findHolding(symbol) >= 0;
+}
+
+int Portfolio::getQuantity(const string& symbol) const {
+    int slot = findHolding(symbol);
+    return (slot >= 0) ? holdings[slot].quantity : 0;
+}
+
+const Ledger& Portfolio::getLedger() const {
+    return ledger;
+}
+
+const vector<Holding>& Portfolio::getHoldings() const {
+    return holdings;
+}
+
+double Portfolio::getRealizedPnL() const {
+    return realizedPnL;
+}
+
+// Helpers: little binary writer/reader for the snapshot payload
+static void putBytes(vector<char>& out, const void* data, size_t length) {
+    const char* bytes = static_cast<const char*>(data);
+    out.insert(out.end(), bytes, bytes + length);
+}
+
+static void putString(vector<char>& out, const string& value) {
+    uint32_t length = value.size();
+    putBytes(out, &length, sizeof(length));
+    putBytes(out, value.data(), length);
+}
+
+static bool getBytes(const char*& p, const char* end, void* data, size_t length) {
+    if ((size_t)(end - p) < length) return false;
+    memcpy(data, p, length);
+    p += length;
+    return true;
 }
 
-int Portfolio::getQuantity(string symbol) const {
-    if (holdings.find(symbol) != holdings.end()) {
-        return holdings.at(symbol).quantity;
+static bool getString(const char*& p, const char* end, string& value) {
+    uint32_t length;
+    if (!getBytes(p, end, &length, sizeof(length)) || (size_t)(end - p) < length) return false;
+    value.assign(p, length);
+    p += length;
+    return true;
+}
+
+static const char SNAPSHOT_MAGIC[8] = {'Q', 'L', 'P', 'O', 'R', 'T', '0', '1'};
+static const uint32_t SNAPSHOT_VERSION = 3;
+
+static_assert(sizeof(PortfolioSnapshotHeader) == 64, "snapshot header must stay 64 bytes");
+
+// Helper: explain why a snapshot's journal couldn't be locked
+static void reportLockFailure(const string& filename) {
+    if (errno == EWOULDBLOCK) {
+        cout << "Error: " << filename << " is in use by another portfolio" << endl;
+    } else {
+        cout << "Error: Could not open the journal for " << filename << endl;
     }
-    return 0;
 }
 
-// Save/Load functions (basic version)
-bool Portfolio::saveToFile(string filename) const {
-    // TODO: Implement file saving
-    cout << "Save functionality coming soon..." << endl;
+// Save: write the snapshot to a temp file, fsync and rename it over the
+// old one, then start an empty journal for the new generation. A crash
+// in between leaves an old-generation journal, which load ignores.
+bool Portfolio::saveToFile(const string& filename) {
+    // Lock the journal first, so files another portfolio is using are left alone
+    string journalFile = TransactionJournal::journalPath(filename);
+    bool sameFile = journal.isOpen() && journal.getPath() == journalFile;
+    TransactionJournal newJournal;
+    if (!sameFile && !newJournal.lock(journalFile)) {
+        reportLockFailure(filename);
+        return false;
+    }
+    
+    vector<char> payload;
+    putString(payload, name);
+    for (const Holding& h : holdings) {
+        int32_t quantity = h.quantity;
+        putString(payload, h.symbol);
+        putBytes(payload, &quantity, sizeof(quantity));
+        putBytes(payload, &h.avgCost, sizeof(h.avgCost));
+        putString(payload, h.purchaseDate);
+    }
+    
+    // Ledger: the names of its symbols, then each column as one array.
+    // Ids in the file index that name list, not the global table.
+    vector<int32_t> fileIds(ledger.symbolIdLimit(), -1);
+    uint32_t numSymbols = 0;
+    for (int id = 0; id < ledger.symbolIdLimit(); id++) {
+        if (!ledger.rowsForSymbol(id).empty()) fileIds[id] = numSymbols++;
+    }
+    putBytes(payload, &numSymbols, sizeof(numSymbols));
+    for (int id = 0; id < ledger.symbolIdLimit(); id++) {
+        if (fileIds[id] >= 0) putString(payload, SymbolTable::global().name(id));
+    }
+    
+    int rows = ledger.size();
+    vector<int32_t> ids(rows), quantities(rows), dates(rows);
+    vector<uint8_t> sides(rows);
+    vector<double> prices(rows);
+    for (int row = 0; row < rows; row++) {
+        ids[row] = fileIds[ledger.getSymbolId(row)];
+        sides[row] = ledger.getSide(row);
+        quantities[row] = ledger.getQuantity(row);
+        prices[row] = ledger.getPrice(row);
+        dates[row] = ledger.getDate(row);
+    }
+    putBytes(payload, ids.data(), rows * sizeof(int32_t));
+    putBytes(payload, sides.data(), rows * sizeof(uint8_t));
+    putBytes(payload, quantities.data(), rows * sizeof(int32_t));
+    putBytes(payload, prices.data(), rows * sizeof(double));
+    putBytes(payload, dates.data(), rows * sizeof(int32_t));
+    
+    PortfolioSnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.numHoldings = holdings.size();
+    header.generation = generation + 1;
+    header.numTransactions = ledger.size();
+    header.payloadBytes = payload.size();
+    header.checksum = TransactionJournal::checksum(payload.data(), payload.size());
+    header.cashBalance = cashBalance;
+    header.realizedPnL = realizedPnL;
+    
+    string tempPath = filename + ".tmp";
+    FILE* out = fopen(tempPath.c_str(), "wb");
+    if (out == nullptr) {
+        cout << "Error: Could not write " << filename << endl;
+        return false;
+    }
+    
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1;
+    ok = ok && fwrite(payload.data(), 1, payload.size(), out) == payload.size();
+    ok = ok && fflush(out) == 0 && fsync(fileno(out)) == 0;
+    ok = (fclose(out) == 0) && ok;
+    
+    if (!ok || rename(tempPath.c_str(), filename.c_str()) != 0) {
+        remove(tempPath.c_str());
+        cout << "Error: Could not write " << filename << endl;
+        return false;
+    }
+    
+    generation = header.generation;
+    snapshotFile = filename;
+    if (!sameFile) {
+        journal.swap(newJournal);   // Releases the previous file
+    }
+    if (!journal.create(generation)) {
+        cout << "Error: Could not create the journal for " << filename << endl;
+        return false;
+    }
+    
+    cout << "✓ Portfolio '" << name << "' saved to " << filename << endl;
     return true;
 }
 
-bool Portfolio::loadFromFile(string filename) {
-    // TODO: Implement file loading
-    cout << "Load functionality coming soon..." << endl;
+// Load: read the snapshot, then replay the journal of the same generation
+bool Portfolio::loadFromFile(const string& filename) {
+    // Lock the journal first, so files another portfolio is using are left alone
+    string journalFile = TransactionJournal::journalPath(filename);
+    bool sameFile = journal.isOpen() && journal.getPath() == journalFile;
+    TransactionJournal newJournal;
+    if (!sameFile && !newJournal.lock(journalFile)) {
+        reportLockFailure(filename);
+        return false;
+    }
+    
+    MappedFile file;
+    if (!file.open(filename) || file.size() < sizeof(PortfolioSnapshotHeader)) {
+        cout << "Error: Could not open " << filename << endl;
+        return false;
+    }
+    
+    PortfolioSnapshotHeader header;
+    memcpy(&header, file.begin(), sizeof(header));
+    const char* p = file.begin() + sizeof(header);
+    const char* end = file.end();
+    
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 ||
+        header.version != SNAPSHOT_VERSION ||
+        header.payloadBytes != (uint64_t)(end - p) ||
+        header.checksum != TransactionJournal::checksum(p, end - p)) {
+        cout << "Error: " << filename << " is not a valid portfolio file" << endl;
+        return false;
+    }
+    
+    // Parse into temporaries so a bad file leaves the portfolio unchanged
+    string loadedName;
+    vector<Holding> loadedHoldings;
+    Ledger loadedLedger;
+    bool ok = getString(p, end, loadedName);
+    for (uint32_t i = 0; ok && i < header.numHoldings; i++) {
+        Holding h;
+        int32_t quantity = 0;
+        ok = getString(p, end, h.symbol) &&
+             getBytes(p, end, &quantity, sizeof(quantity)) &&
+             getBytes(p, end, &h.avgCost, sizeof(h.avgCost)) &&
+             getString(p, end, h.purchaseDate);
+        h.quantity = quantity;
+        h.symbolId = ok ? SymbolTable::global().intern(h.symbol) : -1;
+        loadedHoldings.push_back(h);
+    }
+    
+    uint32_t numSymbols = 0;
+    vector<string> symbolNames;
+    ok = ok && getBytes(p, end, &numSymbols, sizeof(numSymbols));
+    for (uint32_t i = 0; ok && i < numSymbols; i++) {
+        string symbol;
+        ok = getString(p, end, symbol);
+        symbolNames.push_back(symbol);
+    }
+    
+    // Each row takes 21 bytes, which bounds the row count before allocating
+    size_t rows = ok ? header.numTransactions : 0;
+    const size_t rowBytes = 3 * sizeof(int32_t) + sizeof(uint8_t) + sizeof(double);
+    ok = ok && rows <= (size_t)(end - p) / rowBytes;
+    if (!ok) rows = 0;
+    
+    vector<int32_t> ids(rows), quantities(rows), dates(rows);
+    vector<uint8_t> sides(rows);
+    vector<double> prices(rows);
+    ok = ok && getBytes(p, end, ids.data(), rows * sizeof(int32_t)) &&
+         getBytes(p, end, sides.data(), rows * sizeof(uint8_t)) &&
+         getBytes(p, end, quantities.data(), rows * sizeof(int32_t)) &&
+         getBytes(p, end, prices.data(), rows * sizeof(double)) &&
+         getBytes(p, end, dates.data(), rows * sizeof(int32_t));
+    
+    loadedLedger.reserve(rows);
+    for (size_t row = 0; ok && row < rows; row++) {
+        ok = ids[row] >= 0 && ids[row] < (int32_t)numSymbols && sides[row] <= TRADE_SELL;
+        if (ok) {
+            loadedLedger.add(symbolNames[ids[row]], static_cast<TradeSide>(sides[row]),
+                             quantities[row], prices[row], dates[row]);
+        }
+    }
+    if (!ok || p != end) {
+        cout << "Error: " << filename << " is not a valid portfolio file" << endl;
+        return false;
+    }
+    
+    name = loadedName;
+    holdings.swap(loadedHoldings);
+    indexHoldings();
+    ledger = std::move(loadedLedger);
+    cashBalance = header.cashBalance;
+    realizedPnL = header.realizedPnL;
+    generation = header.generation;
+    snapshotFile = filename;
+    
+    // Replay changes made after the snapshot
+    if (!sameFile) {
+        journal.swap(newJournal);
+    }
+    vector<JournalRecord> records;
+    if (journal.open(generation, records)) {
+        for (const JournalRecord& record : records) {
+            if (record.type == JOURNAL_CASH) {
+                applyCash(record.amount);
+            } else if (record.type == JOURNAL_BUY) {
+                applyBuy(record.symbol, record.quantity, record.amount, record.date);
+            } else {
+                applySell(record.symbol, record.quantity, record.amount, record.date);
+            }
+        }
+    } else if (!journal.create(generation)) {
+        cout << "Error: Could not create the journal for " << filename << endl;
+        return false;
+    }
+    
+    cout << "✓ Loaded portfolio '" << name << "' (" << holdings.size() << " holdings, "
+         << records.size() << " journaled changes)" << endl;
     return true;
+}
+
+void Portfolio::sync() {
+    if (journal.isOpen()) {
+        journal.sync();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,248 @@
+// PortfolioBacktester.cpp
+#include "../include/PortfolioBacktester.h"
+#include "../include/DateUtil.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+PortfolioBacktester::PortfolioBacktester(const vector<Stock*>& universe, Strategy* strat, double initialCash,
+                                         int rebalanceEvery, double maxPositionWeight) {
+    stocks = universe;
+    strategy = strat;
+    startingCash = initialCash;
+    rebalanceDays = rebalanceEvery;
+    maxWeight = maxPositionWeight;
+    cash = initialCash;
+    finalValue = 0.0;
+    totalReturn = 0.0;
+    maxDrawdown = 0.0;
+    numTrades = 0;
+    turnover = 0.0;
+}
+
+// Build the shared date index and the [day][symbol] matrices
+void PortfolioBacktester::align() {
+    int numSymbols = stocks.size();
+    
+    // Union of all dates
+    timeline.clear();
+    for (Stock* stock : stocks) {
+        const AlignedVector<int>& dates = stock->getBars().getDates();
+        timeline.insert(timeline.end(), dates.begin(), dates.end());
+    }
+    sort(timeline.begin(), timeline.end());
+    timeline.erase(unique(timeline.begin(), timeline.end()), timeline.end());
+    
+    int numDays = timeline.size();
+    prices.assign((size_t)numDays * numSymbols, 0.0);
+    signals.assign((size_t)numDays * numSymbols, SIGNAL_HOLD);
+    hasBar.assign((size_t)numDays * numSymbols, 0);
+    lastDays.assign(numSymbols, -1);
+    
+    // Walk each symbol's bars alongside the timeline, forward-filling prices
+    vector<int8_t> stockSignals;
+    for (int s = 0; s < numSymbols; s++) {
+        const BarStore& bars = stocks[s]->getBars();
+        strategy->generateSignals(stocks[s], stockSignals);
+        
+        int bar = 0;
+        double lastPrice = 0.0;
+        for (int day = 0; day < numDays; day++) {
+            size_t cell = (size_t)day * numSymbols + s;
+            
+            // Skip duplicate dates within one symbol (keep the last)
+            while (bar < bars.size() && bars.getDate(bar) < timeline[day]) bar++;
+            while (bar + 1 < bars.size() && bars.getDate(bar + 1) == timeline[day]) bar++;
+            
+            if (bar < bars.size() && bars.getDate(bar) == timeline[day]) {
+                lastPrice = bars.getClose(bar);
+                signals[cell] = stockSignals[bar];
+                hasBar[cell] = 1;
+                lastDays[s] = day;
+                bar++;
+            }
+            prices[cell] = lastPrice;
+        }
+    }
+}
+
+// Equal weight across active symbols (capped), sells before buys.
+// Prices are forward-filled, so only symbols with a bar today trade.
+void PortfolioBacktester::rebalance(const double* dayPrices, const int8_t* tradable, const vector<bool>& active,
+                                    vector<int>& shares, double portfolioValue, double& tradedValue) {
+    int numSymbols = stocks.size();
+    
+    int numActive = 0;
+    for (int s = 0; s < numSymbols; s++) {
+        if (active[s]) numActive++;
+    }
+    double weight = (numActive > 0) ? min(1.0 / numActive, maxWeight) : 0.0;
+    
+    vector<int> target(numSymbols, 0);
+    for (int s = 0; s < numSymbols; s++) {
+        if (active[s] && dayPrices[s] > 0) {
+            target[s] = (int)(portfolioValue * weight / dayPrices[s]);
+        }
+    }
+    
+    // Sells first so their cash can fund the buys
+    for (int pass = 0; pass < 2; pass++) {
+        for (int s = 0; s < numSymbols; s++) {
+            if (!tradable[s]) continue;
+            
+            int delta = target[s] - shares[s];
+            bool selling = (delta < 0);
+            if (delta == 0 || selling != (pass == 0)) continue;
+            
+            if (!selling) {
+                // Never spend more cash than we have
+                delta = min(delta, (int)(cash / dayPrices[s]));
+                if (delta <= 0) continue;
+            }
+            
+            double value = delta * dayPrices[s];
+            cash -= value;
+            shares[s] += delta;
+            tradedValue += (value < 0) ? -value : value;
+            numTrades++;
+        }
+    }
+}
+
+void PortfolioBacktester::run(bool verbose) {
+    int numSymbols = stocks.size();
+    
+    if (verbose) {
+        cout << "\nRunning portfolio backtest for: " << strategy->getName() << endl;
+        cout << "Starting cash: $" << startingCash << endl;
+        cout << "Symbols: " << numSymbols << endl;
+        cout << "Processing..." << endl;
+    }
+    
+    align();
+    int numDays = timeline.size();
+    
+    cash = startingCash;
+    numTrades = 0;
+    maxDrawdown = 0.0;
+    equityCurve.assign(numDays, 0.0);
+    
+    vector<int> shares(numSymbols, 0);
+    vector<bool> active(numSymbols, false);
+    double peak = startingCash;
+    double tradedValue = 0.0;
+    double valueSum = 0.0;
+    
+    // One cross-sectional pass per day
+    for (int day = 0; day < numDays; day++) {
+        const double* dayPrices = &prices[(size_t)day * numSymbols];
+        const int8_t* daySignals = &signals[(size_t)day * numSymbols];
+        const int8_t* dayTradable = &hasBar[(size_t)day * numSymbols];
+        
+        bool changed = false;
+        double holdingsValue = 0.0;
+        for (int s = 0; s < numSymbols; s++) {
+            int8_t signal = daySignals[s];
+            bool delisting = (day == lastDays[s] && day < numDays - 1);
+            if (delisting) {
+                // Last bar before the data ends: close out while it can still trade
+                if (active[s] || shares[s] != 0) changed = true;
+                active[s] = false;
+            } else if (!active[s] && (signal & SIGNAL_BUY) && dayPrices[s] > 0) {
+                active[s] = true;
+                changed = true;
+            } else if (active[s] && (signal & SIGNAL_SELL)) {
+                active[s] = false;
+                changed = true;
+            }
+            holdingsValue += shares[s] * dayPrices[s];
+        }
+        
+        double portfolioValue = cash + holdingsValue;
+        bool scheduled = (rebalanceDays > 0 && day % rebalanceDays == 0);
+        if (changed || scheduled) {
+            rebalance(dayPrices, dayTradable, active, shares, portfolioValue, tradedValue);
+        }
+        
+        equityCurve[day] = portfolioValue;
+        valueSum += portfolioValue;
+        
+        // Track max drawdown
+        if (portfolioValue > peak) {
+            peak = portfolioValue;
+        }
+        double drawdown = ((peak - portfolioValue) / peak) * 100.0;
+        if (drawdown > maxDrawdown) {
+            maxDrawdown = drawdown;
+        }
+    }
+    
+    // Liquidate at the last known prices
+    if (numDays > 0) {
+        const double* lastPrices = &prices[(size_t)(numDays - 1) * numSymbols];
+        for (int s = 0; s < numSymbols; s++) {
+            cash += shares[s] * lastPrices[s];
+        }
+    }
+    finalShares = shares;
+    
+    finalValue = cash;
+    totalReturn = ((finalValue - startingCash) / startingCash) * 100.0;
+    turnover = (numDays > 0 && valueSum > 0) ? tradedValue / (valueSum / numDays) : 0.0;
+    
+    if (verbose) {
+        cout << "✓ Backtest complete!" << endl;
+    }
+}
+
+void PortfolioBacktester::displayResults() const {
+    cout << "\n========================================" << endl;
+    cout << "    PORTFOLIO BACKTEST RESULTS" << endl;
+    cout << "========================================" << endl;
+    cout << "Strategy: " << strategy->getName() << endl;
+    cout << "Symbols: " << stocks.size() << endl;
+    if (!timeline.empty()) {
+        cout << "Period: " << DateUtil::formatDate(timeline.front()) << " to "
+             << DateUtil::formatDate(timeline.back()) << " (" << timeline.size() << " days)" << endl;
+    }
+    cout << "----------------------------------------" << endl;
+    cout << fixed << setprecision(2);
+    
+    cout << "\nPerformance:" << endl;
+    cout << "  Starting Capital: $" << startingCash << endl;
+    cout << "  Final Value: $" << finalValue << endl;
+    cout << "  Total Return: " << totalReturn << "%" << endl;
+    cout << "  Max Drawdown: " << maxDrawdown << "%" << endl;
+    
+    cout << "\nTrading Activity:" << endl;
+    cout << "  Total Trades: " << numTrades << endl;
+    cout << "  Turnover: " << turnover << "x" << endl;
+    
+    cout << "========================================" << endl;
+}
+
+double PortfolioBacktester::getTotalReturn() const {
+    return totalReturn;
+}
+
+double PortfolioBacktester::getFinalValue() const {
+    return finalValue;
+}
+
+double PortfolioBacktester::getMaxDrawdown() const {
+    return maxDrawdown;
+}
+
+int PortfolioBacktester::getNumTrades() const {
+    return numTrades;
+}
+
+const vector<double>& PortfolioBacktester::getEquityCurve() const {
+    return equityCurve;
+}
+
+const vector<int>& PortfolioBacktester::getTimeline() const {
+    return timeline;
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+// PriceCache.cpp
+#include "../include/PriceCache.h"
+#include "../include/MappedFile.h"
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+
+using namespace std;
+
+static const char CACHE_MAGIC[8] = {'Q', 'L', 'C', 'A', 'C', 'H', 'E', '1'};
+static const uint32_t CACHE_VERSION = 1;
+
+static_assert(sizeof(PriceCacheHeader) == 64, "cache header must stay 64 bytes");
+
+// Helper: round up to a multiple of 8 bytes
+static size_t align8(size_t bytes) {
+    return (bytes + 7) & ~static_cast<size_t>(7);
+}
+
+string PriceCache::cachePath(const string& csvFile) {
+    return csvFile + ".qlc";
+}
+
+bool PriceCache::sourceInfo(const string& csvFile, int64_t& size, int64_t& mtime) {
+    struct stat info;
+    if (stat(csvFile.c_str(), &info) != 0) {
+        return false;
+    }
+    size = info.st_size;
+    mtime = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000LL + info.st_mtim.tv_nsec;
+    return true;
+}
+
+size_t PriceCache::fileSize(uint64_t rows) {
+    return sizeof(PriceCacheHeader) + align8(rows * sizeof(int32_t)) + rows * 5 * sizeof(double);
+}
+
+bool PriceCache::validHeader(const PriceCacheHeader& header, uint64_t fileBytes) {
+    return memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+           header.version == CACHE_VERSION &&
+           fileBytes == fileSize(header.rows);
+}
+
+// Columns are stored back to back in BarStore order, dates padded to 8 bytes
+size_t PriceCache::columnOffset(int column, uint64_t rows) {
+    size_t offset = sizeof(PriceCacheHeader);
+    if (column > 0) {
+        offset += align8(rows * sizeof(int32_t)) + (column - 1) * rows * sizeof(double);
+    }
+    return offset;
+}
+
+// Load cached columns
+bool PriceCache::load(const string& csvFile, BarStore& bars) {
+    int64_t size, mtime;
+    if (!sourceInfo(csvFile, size, mtime)) {
+        return false;
+    }
+    
+    MappedFile file;
+    if (!file.open(cachePath(csvFile)) || file.size() < sizeof(PriceCacheHeader)) {
+        return false;
+    }
+    
+    PriceCacheHeader header;
+    memcpy(&header, file.begin(), sizeof(header));
+    
+    // Reject foreign, truncated or stale caches
+    if (!validHeader(header, file.size()) ||
+        header.sourceSize != size ||
+        header.sourceMtime != mtime) {
+        return false;
+    }
+    
+    size_t rows = header.rows;
+    const char* base = file.begin();
+    const int32_t* dates = reinterpret_cast<const int32_t*>(base + columnOffset(0, rows));
+    const double* opens = reinterpret_cast<const double*>(base + columnOffset(1, rows));
+    const double* highs = reinterpret_cast<const double*>(base + columnOffset(2, rows));
+    const double* lows = reinterpret_cast<const double*>(base + columnOffset(3, rows));
+    const double* closes = reinterpret_cast<const double*>(base + columnOffset(4, rows));
+    const int64_t* volumes = reinterpret_cast<const int64_t*>(base + columnOffset(5, rows));
+    
+    static_assert(sizeof(int) == sizeof(int32_t), "date column is stored as int32");
+    static_assert(sizeof(long long) == sizeof(int64_t), "volume column is stored as int64");
+    
+    bars.reserve(bars.size() + rows);
+    bars.append(dates, opens, highs, lows, closes,
+                reinterpret_cast<const long long*>(volumes), rows);
+    
+    return true;
+}
+
+// Write cache file (to a temp file first, then rename over the old one)
+bool PriceCache::save(const string& csvFile, const BarStore& bars) {
+    size_t rows = bars.size();
+    
+    PriceCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.rows = rows;
+    if (!sourceInfo(csvFile, header.sourceSize, header.sourceMtime)) {
+        return false;
+    }
+    
+    string finalPath = cachePath(csvFile);
+    string tempPath = finalPath + ".tmp";
+    FILE* out = fopen(tempPath.c_str(), "wb");
+    if (out == nullptr) {
+        return false;
+    }
+    
+    // Date column is padded to 8 bytes so the double columns stay aligned
+    const char zeros[8] = {0};
+    size_t dateBytes = rows * sizeof(int32_t);
+    size_t padding = align8(dateBytes) - dateBytes;
+    
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1;
+    ok = ok && fwrite(bars.getDates().data(), sizeof(int32_t), rows, out) == rows;
+    ok = ok && fwrite(zeros, 1, padding, out) == padding;
+    ok = ok && fwrite(bars.getOpens().data(), sizeof(double), rows, out) == rows;
+    ok = ok && fwrite(bars.getHighs().data(), sizeof(double), rows, out) == rows;
+    ok = ok && fwrite(bars.getLows().data(), sizeof(double), rows, out) == rows;
+    ok = ok && fwrite(bars.getCloses().data(), sizeof(double), rows, out) == rows;
+    ok = ok && fwrite(bars.getVolumes().data(), sizeof(int64_t), rows, out) == rows;
+    
+    ok = (fclose(out) == 0) && ok;
+    
+    if (!ok || rename(tempPath.c_str(), finalPath.c_str()) != 0) {
+        remove(tempPath.c_str());
+        return false;
+    }
+    
+    return true;
+}
@@ -0,0 +1,213 @@
+// RollingAnalytics.cpp
+#include "../include/RollingAnalytics.h"
+#include "../include/Indicators.h"
+#include "../include/ThreadPool.h"
+#include "../include/DateUtil.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// Rolling mean
+void RollingAnalytics::mean(const double* values, int n, int window, double* out) {
+    RollingSum sum(window);
+    for (int i = 0; i < n; i++) {
+        sum.add(values, i);
+        out[i] = (i >= window - 1) ? sum.sum / window : 0.0;
+    }
+}
+
+// Rolling annualized volatility (population standard deviation, as in
+// Analytics::calculateVolatility)
+void RollingAnalytics::volatility(const double* returns, const double* means, int n, int window, double* out) {
+    RollingVariance variance(window);
+    for (int i = 0; i < n; i++) {
+        variance.add(returns, means, i);
+        out[i] = (i >= window - 1) ? sqrt(variance.variance()) * sqrt(252) : 0.0;
+    }
+}
+
+// Rolling Sharpe ratio from the rolling mean and volatility
+void RollingAnalytics::sharpeRatio(const double* means, const double* volatility, int n, double riskFreeRate, double* out) {
+    for (int i = 0; i < n; i++) {
+        out[i] = (volatility[i] > 0.0) ? (means[i] * 252 - riskFreeRate) / volatility[i] : 0.0;
+    }
+}
+
+// Rolling beta: covariance with the market over the market variance
+void RollingAnalytics::beta(const double* returns, const double* marketReturns, const double* means,
+                            const double* marketMeans, int n, int window, double* out) {
+    RollingCovariance covariance(window);
+    RollingVariance marketVariance(window);
+    for (int i = 0; i < n; i++) {
+        covariance.add(returns, marketReturns, means, marketMeans, i);
+        marketVariance.add(marketReturns, marketMeans, i);
+        
+        double variance = marketVariance.variance();
+        out[i] = (i >= window - 1 && variance > 0.0) ? covariance.covariance() / variance : 0.0;
+    }
+}
+
+// Rolling drawdown. The window peak comes from a monotonic queue of day
+// indices with decreasing prices: each day is pushed and popped at most
+// once, so the whole series is O(n) for any window.
+void RollingAnalytics::drawdown(const double* prices, int n, int window, double* out) {
+    if (n <= 0) return;
+    
+    if (window <= 0) {
+        double peak = prices[0];
+        for (int i = 0; i < n; i++) {
+            peak = max(peak, prices[i]);
+            out[i] = (peak > 0.0) ? ((peak - prices[i]) / peak) * 100.0 : 0.0;
+        }
+        return;
+    }
+    
+    vector<int> queue(n);
+    int head = 0;
+    int tail = 0;
+    for (int i = 0; i < n; i++) {
+        while (tail > head && prices[queue[tail - 1]] <= prices[i]) {
+            tail--;
+        }
+        queue[tail++] = i;
+        if (queue[head] <= i - window) {
+            head++;
+        }
+        
+        double peak = prices[queue[head]];
+        out[i] = (peak > 0.0) ? ((peak - prices[i]) / peak) * 100.0 : 0.0;
+    }
+}
+
+// Helper: daily returns, with 0 where the previous price is 0
+void RollingAnalytics::dailyReturns(const double* prices, int n, double* out) {
+    if (n <= 0) return;
+    
+    out[0] = 0.0;
+    for (int i = 1; i < n; i++) {
+        double yesterday = prices[i - 1];
+        out[i] = (yesterday != 0) ? ((prices[i] - yesterday) / yesterday) * 100.0 : 0.0;
+    }
+}
+
+// Helper: as-of join of the benchmark closes onto the stock's dates.
+// Dates before the benchmark's first bar have no close (0.0).
+int RollingAnalytics::alignCloses(const BarStore& bars, const BarStore& benchmark, double* out) {
+    int n = bars.size();
+    int m = benchmark.size();
+    int first = n;
+    int j = -1;
+    for (int i = 0; i < n; i++) {
+        int date = bars.getDate(i);
+        while (j + 1 < m && benchmark.getDate(j + 1) <= date) {
+            j++;
+        }
+        if (j < 0) {
+            out[i] = 0.0;
+            continue;
+        }
+        out[i] = benchmark.getClose(j);
+        first = min(first, i);
+    }
+    return first;
+}
+
+RollingMetrics RollingAnalytics::compute(const Stock* stock, int window, const Stock* benchmark, double riskFreeRate) {
+    RollingMetrics metrics;
+    metrics.symbol = stock->getSymbol();
+    
+    const BarStore& bars = stock->getBars();
+    int n = bars.size();
+    if (n == 0 || window < 1) return metrics;
+    
+    const double* closes = bars.getCloses().data();
+    metrics.returns.assign(n, 0.0);
+    metrics.volatility.assign(n, 0.0);
+    metrics.sharpeRatio.assign(n, 0.0);
+    metrics.drawdown.assign(n, 0.0);
+    
+    dailyReturns(closes, n, metrics.returns.data());
+    drawdown(closes, n, window, metrics.drawdown.data());
+    if (n < 2) return metrics;
+    
+    // Return series start on day 1: the first day has no return
+    int count = n - 1;
+    const double* returns = metrics.returns.data() + 1;
+    Series means(count);
+    mean(returns, count, window, means.data());
+    volatility(returns, means.data(), count, window, metrics.volatility.data() + 1);
+    sharpeRatio(means.data(), metrics.volatility.data() + 1, count, riskFreeRate, metrics.sharpeRatio.data() + 1);
+    
+    if (benchmark != nullptr && benchmark->getDataSize() > 0) {
+        Series marketCloses(n);
+        Series marketReturns(n);
+        int first = alignCloses(bars, benchmark->getBars(), marketCloses.data());
+        dailyReturns(marketCloses.data(), n, marketReturns.data());
+        metrics.beta.assign(n, 0.0);
+        
+        // Beta starts once the benchmark has a close: market returns are
+        // real from day first + 1, and the window fills from there
+        int aligned = count - first;
+        if (aligned > 0) {
+            Series marketMeans(aligned);
+            mean(marketReturns.data() + 1 + first, aligned, window, marketMeans.data());
+            beta(returns + first, marketReturns.data() + 1 + first, means.data() + first, marketMeans.data(),
+                 aligned, window, metrics.beta.data() + 1 + first);
+        }
+    }
+    
+    return metrics;
+}
+
+vector<RollingMetrics> RollingAnalytics::computeBatch(const vector<Stock*>& stocks, int window,
+                                                      const Stock* benchmark, double riskFreeRate, int numThreads) {
+    vector<RollingMetrics> results(stocks.size());
+    
+    ThreadPool pool(numThreads);
+    for (size_t i = 0; i < stocks.size(); i++) {
+        pool.submit([&, i] {
+            results[i] = compute(stocks[i], window, benchmark, riskFreeRate);
+        });
+    }
+    pool.waitAll();
+    
+    return results;
+}
+
+void RollingAnalytics::displayResults(const RollingMetrics& metrics, const Stock* stock, int numDays) {
+    int n = metrics.returns.size();
+    int start = max(0, n - numDays);
+    bool hasBeta = !metrics.beta.empty();
+    
+    cout << "\n=== Rolling Analytics for " << metrics.symbol << " ===" << endl;
+    cout << fixed << setprecision(2);
+    cout << "Date\t\tReturn%\tVol%\tSharpe\t" << (hasBeta ? "Beta\t" : "") << "DD%" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    for (int i = start; i < n; i++) {
+        cout << DateUtil::formatDate(stock->getBars().getDate(i)) << "\t"
+             << metrics.returns[i] << "\t" << metrics.volatility[i] << "\t" << metrics.sharpeRatio[i] << "\t";
+        if (hasBeta) {
+            cout << metrics.beta[i] << "\t";
+        }
+        cout << metrics.drawdown[i] << endl;
+    }
+}
+
+void RollingAnalytics::displaySummary(const vector<RollingMetrics>& batch) {
+    cout << "\n=== Rolling Analytics (latest day) ===" << endl;
+    cout << fixed << setprecision(2);
+    cout << "Symbol\tVol%\tSharpe\tBeta\tDD%" << endl;
+    cout << "------------------------------------------" << endl;
+    for (const RollingMetrics& metrics : batch) {
+        if (metrics.returns.empty()) continue;
+        
+        int last = metrics.returns.size() - 1;
+        cout << metrics.symbol << "\t" << metrics.volatility[last] << "\t" << metrics.sharpeRatio[last] << "\t";
+        if (metrics.beta.empty()) cout << "N/A";
+        else cout << metrics.beta[last];
+        cout << "\t" << metrics.drawdown[last] << endl;
+    }
+}
\ No newline at end of file
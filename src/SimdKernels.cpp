@@ -0,0 +1,425 @@
+// SimdKernels.cpp
+#include "../include/SimdKernels.h"
+#include <cmath>
+#include <limits>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define QUANTLAB_X86 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define QUANTLAB_NEON 1
+#endif
+
+using namespace std;
+
+// ===== Scalar kernels =====
+
+int SimdKernels::dailyReturnsScalar(const double* prices, int n, double* out) {
+    int count = 0;
+    for (int i = 1; i < n; i++) {
+        double yesterday = prices[i - 1];
+        if (yesterday != 0) {
+            out[count++] = ((prices[i] - yesterday) / yesterday) * 100.0;
+        }
+    }
+    return count;
+}
+
+// Sums are taken around the first value, which keeps sum-of-squares
+// accurate when the mean is large compared to the spread.
+void SimdKernels::meanVarianceScalar(const double* data, int n, double& mean, double& variance) {
+    if (n <= 0) {
+        mean = 0.0;
+        variance = 0.0;
+        return;
+    }
+    
+    double shift = data[0];
+    double sum = 0.0;
+    double sumSq = 0.0;
+    for (int i = 0; i < n; i++) {
+        double d = data[i] - shift;
+        sum += d;
+        sumSq += d * d;
+    }
+    
+    mean = shift + sum / n;
+    variance = max(0.0, (sumSq - sum * sum / n) / n);
+}
+
+double SimdKernels::maxDrawdownScalar(const double* prices, int n) {
+    if (n < 2) return 0.0;
+    
+    double maxDrawdown = 0.0;
+    double peak = prices[0];
+    for (int i = 1; i < n; i++) {
+        if (prices[i] > peak) {
+            peak = prices[i];
+        }
+        double drawdown = ((peak - prices[i]) / peak) * 100.0;
+        if (drawdown > maxDrawdown) {
+            maxDrawdown = drawdown;
+        }
+    }
+    return maxDrawdown;
+}
+
+void SimdKernels::crossProduct4x8Scalar(const double* a, const double* b, int n, int stride,
+                                       double* out, int outStride) {
+    double sums[4][8] = {};
+    for (int k = 0; k < n; k++) {
+        const double* rowA = a + (size_t)k * stride;
+        const double* rowB = b + (size_t)k * stride;
+        for (int r = 0; r < 4; r++) {
+            for (int c = 0; c < 8; c++) {
+                sums[r][c] += rowA[r] * rowB[c];
+            }
+        }
+    }
+    
+    for (int r = 0; r < 4; r++) {
+        for (int c = 0; c < 8; c++) {
+            out[r * outStride + c] += sums[r][c];
+        }
+    }
+}
+
+// ===== AVX2 kernels =====
+
+#ifdef QUANTLAB_X86
+
+__attribute__((target("avx2")))
+static int dailyReturnsAVX2(const double* prices, int n, double* out) {
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    const __m256d zero = _mm256_setzero_pd();
+    int count = 0;
+    int i = 1;
+    
+    for (; i + 4 <= n; i += 4) {
+        __m256d yesterday = _mm256_loadu_pd(prices + i - 1);
+        __m256d today = _mm256_loadu_pd(prices + i);
+        
+        // Blocks containing a zero price take the scalar path
+        if (_mm256_movemask_pd(_mm256_cmp_pd(yesterday, zero, _CMP_EQ_OQ)) != 0) {
+            count += SimdKernels::dailyReturnsScalar(prices + i - 1, 5, out + count);
+            continue;
+        }
+        
+        __m256d ret = _mm256_mul_pd(_mm256_div_pd(_mm256_sub_pd(today, yesterday), yesterday), hundred);
+        _mm256_storeu_pd(out + count, ret);
+        count += 4;
+    }
+    
+    count += SimdKernels::dailyReturnsScalar(prices + i - 1, n - i + 1, out + count);
+    return count;
+}
+
+__attribute__((target("avx2")))
+static void meanVarianceAVX2(const double* data, int n, double& mean, double& variance) {
+    if (n < 8) {
+        SimdKernels::meanVarianceScalar(data, n, mean, variance);
+        return;
+    }
+    
+    const __m256d shift = _mm256_set1_pd(data[0]);
+    
+    // Two accumulator pairs to hide add latency
+    __m256d sumA = _mm256_setzero_pd(), sumB = _mm256_setzero_pd();
+    __m256d sqA = _mm256_setzero_pd(), sqB = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d a = _mm256_sub_pd(_mm256_loadu_pd(data + i), shift);
+        __m256d b = _mm256_sub_pd(_mm256_loadu_pd(data + i + 4), shift);
+        sumA = _mm256_add_pd(sumA, a);
+        sumB = _mm256_add_pd(sumB, b);
+        sqA = _mm256_add_pd(sqA, _mm256_mul_pd(a, a));
+        sqB = _mm256_add_pd(sqB, _mm256_mul_pd(b, b));
+    }
+    
+    double sums[4], squares[4];
+    _mm256_storeu_pd(sums, _mm256_add_pd(sumA, sumB));
+    _mm256_storeu_pd(squares, _mm256_add_pd(sqA, sqB));
+    double sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    double sumSq = (squares[0] + squares[1]) + (squares[2] + squares[3]);
+    
+    for (; i < n; i++) {
+        double d = data[i] - data[0];
+        sum += d;
+        sumSq += d * d;
+    }
+    
+    mean = data[0] + sum / n;
+    variance = max(0.0, (sumSq - sum * sum / n) / n);
+}
+
+// Running peak via an in-register prefix max of each block of 4
+__attribute__((target("avx2")))
+static double maxDrawdownAVX2(const double* prices, int n) {
+    if (n < 2) return 0.0;
+    
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    __m256d peak = _mm256_set1_pd(prices[0]);
+    __m256d maxDrawdown = _mm256_setzero_pd();
+    int i = 0;
+    
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(prices + i);
+        
+        // [a b c d] -> [a, max(a,b), max(a..c), max(a..d)]
+        __m256d scan = _mm256_max_pd(v, _mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)));
+        scan = _mm256_max_pd(scan, _mm256_permute4x64_pd(scan, _MM_SHUFFLE(1, 0, 0, 0)));
+        
+        __m256d running = _mm256_max_pd(scan, peak);
+        __m256d drawdown = _mm256_mul_pd(_mm256_div_pd(_mm256_sub_pd(running, v), running), hundred);
+        maxDrawdown = _mm256_max_pd(maxDrawdown, drawdown);
+        
+        // Carry the last lane into the next block
+        peak = _mm256_permute4x64_pd(running, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    
+    double lanes[4];
+    _mm256_storeu_pd(lanes, maxDrawdown);
+    double result = max(max(lanes[0], lanes[1]), max(lanes[2], lanes[3]));
+    
+    double scalarPeak = _mm256_cvtsd_f64(peak);
+    for (; i < n; i++) {
+        if (prices[i] > scalarPeak) {
+            scalarPeak = prices[i];
+        }
+        double drawdown = ((scalarPeak - prices[i]) / scalarPeak) * 100.0;
+        if (drawdown > result) {
+            result = drawdown;
+        }
+    }
+    
+    return result;
+}
+
+// 8 accumulators (4 rows x 2 vectors) stay in registers; each step is
+// 4 broadcasts and 2 loads for 8 multiply-adds
+__attribute__((target("avx2")))
+static void crossProduct4x8AVX2(const double* a, const double* b, int n, int stride,
+                                double* out, int outStride) {
+    __m256d sum0L = _mm256_setzero_pd(), sum0R = _mm256_setzero_pd();
+    __m256d sum1L = _mm256_setzero_pd(), sum1R = _mm256_setzero_pd();
+    __m256d sum2L = _mm256_setzero_pd(), sum2R = _mm256_setzero_pd();
+    __m256d sum3L = _mm256_setzero_pd(), sum3R = _mm256_setzero_pd();
+    
+    for (int k = 0; k < n; k++) {
+        const double* rowA = a + (size_t)k * stride;
+        const double* rowB = b + (size_t)k * stride;
+        __m256d left = _mm256_loadu_pd(rowB);
+        __m256d right = _mm256_loadu_pd(rowB + 4);
+        
+        __m256d x = _mm256_broadcast_sd(rowA);
+        sum0L = _mm256_add_pd(sum0L, _mm256_mul_pd(x, left));
+        sum0R = _mm256_add_pd(sum0R, _mm256_mul_pd(x, right));
+        x = _mm256_broadcast_sd(rowA + 1);
+        sum1L = _mm256_add_pd(sum1L, _mm256_mul_pd(x, left));
+        sum1R = _mm256_add_pd(sum1R, _mm256_mul_pd(x, right));
+        x = _mm256_broadcast_sd(rowA + 2);
+        sum2L = _mm256_add_pd(sum2L, _mm256_mul_pd(x, left));
+        sum2R = _mm256_add_pd(sum2R, _mm256_mul_pd(x, right));
+        x = _mm256_broadcast_sd(rowA + 3);
+        sum3L = _mm256_add_pd(sum3L, _mm256_mul_pd(x, left));
+        sum3R = _mm256_add_pd(sum3R, _mm256_mul_pd(x, right));
+    }
+    
+    __m256d sums[8] = {sum0L, sum0R, sum1L, sum1R, sum2L, sum2R, sum3L, sum3R};
+    for (int r = 0; r < 4; r++) {
+        double* target = out + r * outStride;
+        _mm256_storeu_pd(target, _mm256_add_pd(_mm256_loadu_pd(target), sums[2 * r]));
+        _mm256_storeu_pd(target + 4, _mm256_add_pd(_mm256_loadu_pd(target + 4), sums[2 * r + 1]));
+    }
+}
+
+#endif
+
+// ===== NEON kernels =====
+
+#ifdef QUANTLAB_NEON
+
+static int dailyReturnsNEON(const double* prices, int n, double* out) {
+    const float64x2_t hundred = vdupq_n_f64(100.0);
+    int count = 0;
+    int i = 1;
+    
+    for (; i + 2 <= n; i += 2) {
+        float64x2_t yesterday = vld1q_f64(prices + i - 1);
+        float64x2_t today = vld1q_f64(prices + i);
+        
+        if (prices[i - 1] == 0 || prices[i] == 0) {
+            count += SimdKernels::dailyReturnsScalar(prices + i - 1, 3, out + count);
+            continue;
+        }
+        
+        float64x2_t ret = vmulq_f64(vdivq_f64(vsubq_f64(today, yesterday), yesterday), hundred);
+        vst1q_f64(out + count, ret);
+        count += 2;
+    }
+    
+    count += SimdKernels::dailyReturnsScalar(prices + i - 1, n - i + 1, out + count);
+    return count;
+}
+
+static void meanVarianceNEON(const double* data, int n, double& mean, double& variance) {
+    if (n < 4) {
+        SimdKernels::meanVarianceScalar(data, n, mean, variance);
+        return;
+    }
+    
+    const float64x2_t shift = vdupq_n_f64(data[0]);
+    float64x2_t sumA = vdupq_n_f64(0.0), sumB = vdupq_n_f64(0.0);
+    float64x2_t sqA = vdupq_n_f64(0.0), sqB = vdupq_n_f64(0.0);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float64x2_t a = vsubq_f64(vld1q_f64(data + i), shift);
+        float64x2_t b = vsubq_f64(vld1q_f64(data + i + 2), shift);
+        sumA = vaddq_f64(sumA, a);
+        sumB = vaddq_f64(sumB, b);
+        sqA = vaddq_f64(sqA, vmulq_f64(a, a));
+        sqB = vaddq_f64(sqB, vmulq_f64(b, b));
+    }
+    
+    double sum = vaddvq_f64(vaddq_f64(sumA, sumB));
+    double sumSq = vaddvq_f64(vaddq_f64(sqA, sqB));
+    for (; i < n; i++) {
+        double d = data[i] - data[0];
+        sum += d;
+        sumSq += d * d;
+    }
+    
+    mean = data[0] + sum / n;
+    variance = max(0.0, (sumSq - sum * sum / n) / n);
+}
+
+static double maxDrawdownNEON(const double* prices, int n) {
+    if (n < 2) return 0.0;
+    
+    const float64x2_t hundred = vdupq_n_f64(100.0);
+    float64x2_t peak = vdupq_n_f64(prices[0]);
+    float64x2_t maxDrawdown = vdupq_n_f64(0.0);
+    int i = 0;
+    
+    for (; i + 2 <= n; i += 2) {
+        float64x2_t v = vld1q_f64(prices + i);
+        
+        // [a b] -> [a, max(a,b)]
+        float64x2_t scan = vmaxq_f64(v, vdupq_laneq_f64(v, 0));
+        float64x2_t running = vmaxq_f64(scan, peak);
+        float64x2_t drawdown = vmulq_f64(vdivq_f64(vsubq_f64(running, v), running), hundred);
+        maxDrawdown = vmaxq_f64(maxDrawdown, drawdown);
+        peak = vdupq_laneq_f64(running, 1);
+    }
+    
+    double result = vmaxvq_f64(maxDrawdown);
+    double scalarPeak = vgetq_lane_f64(peak, 0);
+    for (; i < n; i++) {
+        if (prices[i] > scalarPeak) {
+            scalarPeak = prices[i];
+        }
+        double drawdown = ((scalarPeak - prices[i]) / scalarPeak) * 100.0;
+        if (drawdown > result) {
+            result = drawdown;
+        }
+    }
+    
+    return result;
+}
+
+static void crossProduct4x8NEON(const double* a, const double* b, int n, int stride,
+                                double* out, int outStride) {
+    float64x2_t sums[4][4];
+    for (int r = 0; r < 4; r++) {
+        for (int v = 0; v < 4; v++) {
+            sums[r][v] = vdupq_n_f64(0.0);
+        }
+    }
+    
+    for (int k = 0; k < n; k++) {
+        const double* rowA = a + (size_t)k * stride;
+        const double* rowB = b + (size_t)k * stride;
+        float64x2_t columns[4] = {vld1q_f64(rowB), vld1q_f64(rowB + 2), vld1q_f64(rowB + 4), vld1q_f64(rowB + 6)};
+        for (int r = 0; r < 4; r++) {
+            float64x2_t x = vdupq_n_f64(rowA[r]);
+            for (int v = 0; v < 4; v++) {
+                sums[r][v] = vaddq_f64(sums[r][v], vmulq_f64(x, columns[v]));
+            }
+        }
+    }
+    
+    for (int r = 0; r < 4; r++) {
+        double* target = out + r * outStride;
+        for (int v = 0; v < 4; v++) {
+            vst1q_f64(target + 2 * v, vaddq_f64(vld1q_f64(target + 2 * v), sums[r][v]));
+        }
+    }
+}
+
+#endif
+
+// ===== Runtime dispatch =====
+
+struct KernelTable {
+    const char* name;
+    int (*dailyReturns)(const double*, int, double*);
+    void (*meanVariance)(const double*, int, double&, double&);
+    double (*maxDrawdown)(const double*, int);
+    void (*crossProduct4x8)(const double*, const double*, int, int, double*, int);
+};
+
+static KernelTable scalarKernels() {
+    return {"scalar", SimdKernels::dailyReturnsScalar, SimdKernels::meanVarianceScalar,
+            SimdKernels::maxDrawdownScalar, SimdKernels::crossProduct4x8Scalar};
+}
+
+// Best kernel set for this CPU, detected once
+static KernelTable detectKernels() {
+#if defined(QUANTLAB_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {"AVX2", dailyReturnsAVX2, meanVarianceAVX2, maxDrawdownAVX2, crossProduct4x8AVX2};
+    }
+#elif defined(QUANTLAB_NEON)
+    // Advanced SIMD is mandatory on AArch64
+    return {"NEON", dailyReturnsNEON, meanVarianceNEON, maxDrawdownNEON, crossProduct4x8NEON};
+#endif
+    return scalarKernels();
+}
+
+// Both tables are built once and never change; forceScalar only flips
+// which one is used, so it's safe while other threads run kernels
+static atomic<bool> scalarOnly(false);
+
+static const KernelTable& kernels() {
+    static const KernelTable detected = detectKernels();
+    static const KernelTable scalar = scalarKernels();
+    return scalarOnly.load(memory_order_relaxed) ? scalar : detected;
+}
+
+int SimdKernels::dailyReturns(const double* prices, int n, double* out) {
+    return kernels().dailyReturns(prices, n, out);
+}
+
+void SimdKernels::meanVariance(const double* data, int n, double& mean, double& variance) {
+    kernels().meanVariance(data, n, mean, variance);
+}
+
+double SimdKernels::maxDrawdown(const double* prices, int n) {
+    return kernels().maxDrawdown(prices, n);
+}
+
+void SimdKernels::crossProduct4x8(const double* a, const double* b, int n, int stride,
+                                  double* out, int outStride) {
+    kernels().crossProduct4x8(a, b, n, stride, out, outStride);
+}
+
+const char* SimdKernels::activeKernel() {
+    return kernels().name;
+}
+
+void SimdKernels::forceScalar(bool enabled) {
+    scalarOnly.store(enabled, memory_order_relaxed);
+}
@@ -1,160 +1,357 @@
 // Stock.cpp
 #include "../include/Stock.h"
+#include "../include/MappedFile.h"
+#include "../include/PriceCache.h"
+#include "../include/DateUtil.h"
+#include "../include/BarReader.h"
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <cmath>
+#include <cstring>
 
 using namespace std;
 
-// Helper function to trim spaces
-string trim(const string& str) {
-    size_t start = str.find_first_not_of(" \t\r\n");
-    size_t end = str.find_last_not_of(" \t\r\n");
-    if (start == string::npos) return "";
-    return str.substr(start, end - start + 1);
+// Helper: count lines so the columns can be sized up front
+static size_t countLines(const char* p, const char* end) {
+    size_t lines = 0;
+    while (p < end) {
+        const char* nl = static_cast<const char*>(memchr(p, '\n', end - p));
+        lines++;
+        if (nl == nullptr) break;
+        p = nl + 1;
+    }
+    return lines;
 }
 
 // Constructor
 Stock::Stock(string sym, string stockName) {
     symbol = sym;
     name = stockName;
+    resetIndicators();
+}
+
+bool Stock::useBinaryCache = true;
+bool Stock::eagerIndicators = false;
+atomic<unsigned long> Stock::nextRevision(1);
+
+void Stock::setUseBinaryCache(bool enabled) {
+    useBinaryCache = enabled;
+}
+
+void Stock::setEagerIndicators(bool enabled) {
+    eagerIndicators = enabled;
 }
 
 // Load data from CSV file
 bool Stock::loadFromCSV(string filename) {
-    ifstream file(filename);
+    string message;
+    bool loaded = loadFromCSV(filename, message);
+    
+    if (!message.empty()) {
+        cout << (loaded ? "Warning: " : "Error: ") << message << endl;
+    }
+    
+    if (loaded && eagerIndicators) {
+        calculateAllIndicators();
+    }
+    
+    return loaded;
+}
+
+// Load data from CSV file without printing (safe to call from worker threads).
+// A valid binary cache is used when present, otherwise the CSV is parsed
+// and the cache is (re)written for the next run.
+bool Stock::loadFromCSV(const string& filename, string& message) {
+    message.clear();
+    
+    // The cache holds one file's bars on their own, so it's only used
+    // (read or written) when the stock has no data yet; loading onto
+    // existing bars always parses the CSV
+    bool cacheable = useBinaryCache && bars.empty();
+    if (cacheable && PriceCache::load(filename, bars)) {
+        resetIndicators();
+        return true;
+    }
+    
+    if (!parseCSV(filename, message)) {
+        return false;
+    }
+    
+    if (cacheable) {
+        PriceCache::save(filename, bars);
+    }
+    
+    // Indicators are computed on first use unless eager mode is on
+    resetIndicators();
     
-    if (!file.is_open()) {
-        cout << "Error: Could not open " << filename << endl;
+    return true;
+}
+
+// Append a bar and extend the cached indicators
+bool Stock::appendBar(int date, double open, double high, double low, double close, long long volume) {
+    if (!bars.empty() && date < bars.getDate(bars.size() - 1)) {
+        cout << "Error: bar date " << DateUtil::formatDate(date) << " is before the last bar of " << symbol << endl;
+        return false;
+    }
+    
+    bars.append(date, open, high, low, close, volume);
+    indicators.extend(bars.getCloses());
+    bumpRevision();
+    return true;
+}
+
+// Append a block of bars column by column
+bool Stock::appendBars(const BarStore& block) {
+    if (block.empty()) {
+        return true;
+    }
+    if (!bars.empty() && block.getDate(0) < bars.getDate(bars.size() - 1)) {
+        cout << "Error: bar date " << DateUtil::formatDate(block.getDate(0)) << " is before the last bar of " << symbol << endl;
         return false;
     }
     
-    string line;
+    bars.append(block.getDates().data(), block.getOpens().data(), block.getHighs().data(),
+                block.getLows().data(), block.getCloses().data(), block.getVolumes().data(), block.size());
+    indicators.extend(bars.getCloses());
+    bumpRevision();
+    return true;
+}
+
+// Drop the oldest bars, indicators stay aligned with the bars
+void Stock::trimFront(int count) {
+    bars.eraseFront(count);
+    indicators.eraseFront(count);
+    bumpRevision();
+}
+
+int Stock::getIndicatorLookback() const {
+    return indicators.lookback();
+}
+
+// Parse CSV file
+// The file is memory-mapped and parsed in place, no per-row strings are built.
+bool Stock::parseCSV(const string& filename, string& message) {
+    MappedFile file;
+    
+    if (!file.open(filename)) {
+        message = "Could not open " + filename;
+        return false;
+    }
+    
+    const char* p = file.begin();
+    const char* end = file.end();
+    
+    // Pre-size columns (minus the header line)
+    size_t rows = countLines(p, end);
+    if (rows > 0) rows--;
+    size_t firstRow = bars.size();
+    bars.reserve(firstRow + rows);
+    
     int lineNumber = 0;
+    int skippedLines = 0;
+    int firstSkipped = 0;
     
-    while (getline(file, line)) {
+    while (p < end) {
+        const char* nl = static_cast<const char*>(memchr(p, '\n', end - p));
+        const char* lineEnd = nl ? nl : end;
+        const char* next = nl ? nl + 1 : end;
+        
+        // Handle Windows line endings
+        if (lineEnd > p && *(lineEnd - 1) == '\r') {
+            lineEnd--;
+        }
+        
         lineNumber++;
         
-        // Skip header
-        if (lineNumber == 1) continue;
+        // Skip header and blank lines
+        if (lineNumber == 1 || CSVBarReader::isBlankLine(p, lineEnd)) {
+            p = next;
+            continue;
+        }
         
-        // Parse line
-        stringstream ss(line);
-        string date, open, high, low, close, volume;
+        int date;
+        double open, high, low, close;
+        long long volume;
         
-        getline(ss, date, ',');
-        getline(ss, open, ',');
-        getline(ss, high, ',');
-        getline(ss, low, ',');
-        getline(ss, close, ',');
-        getline(ss, volume, ',');
+        if (!CSVBarReader::parseLine(p, lineEnd, date, open, high, low, close, volume)) {
+            if (skippedLines == 0) firstSkipped = lineNumber;
+            skippedLines++;
+            p = next;
+            continue;
+        }
         
-        // Trim and store
-        dates.push_back(trim(date));
-        openPrices.push_back(stod(trim(open)));
-        highPrices.push_back(stod(trim(high)));
-        lowPrices.push_back(stod(trim(low)));
-        closePrices.push_back(stod(trim(close)));
-        volumes.push_back(stoll(trim(volume)));
+        bars.append(date, open, high, low, close, volume);
+        
+        p = next;
     }
     
-    file.close();
+    // Nothing usable: say what a row should look like
+    if (skippedLines > 0 && bars.size() == firstRow) {
+        message = "no valid rows in " + filename + " (line " + to_string(firstSkipped) +
+                  "): expected Date,Open,High,Low,Close,Volume with YYYY-MM-DD dates";
+        return false;
+    }
     
-    // Calculate indicators after loading data
-    calculateAllIndicators();
+    if (skippedLines > 0) {
+        message = "skipped " + to_string(skippedLines) + " malformed line(s) in " + filename;
+    }
     
     return true;
 }
 
 // Getters
-string Stock::getSymbol() const {
+const string& Stock::getSymbol() const {
     return symbol;
 }
 
-string Stock::getName() const {
+const string& Stock::getName() const {
     return name;
 }
 
 int Stock::getDataSize() const {
-    return dates.size();
+    return bars.size();
+}
+
+unsigned long Stock::getRevision() const {
+    return revision;
 }
 
 double Stock::getClosePrice(int index) const {
-    if (index >= 0 && index < closePrices.size()) {
-        return closePrices[index];
+    if (index >= 0 && index < bars.size()) {
+        return bars.getClose(index);
     }
     return 0.0;
 }
 
 vector<double> Stock::getAllClosePrices() const {
-    return closePrices;
+    const Series& closes = bars.getCloses();
+    return vector<double>(closes.begin(), closes.end());
+}
+
+string Stock::getDate(int index) const {
+    if (index >= 0 && index < bars.size()) {
+        return DateUtil::formatDate(bars.getDate(index));
+    }
+    return "";
+}
+
+const BarStore& Stock::getBars() const {
+    return bars;
 }
 
 // Display summary
 void Stock::displaySummary() const {
     cout << "\n=== " << symbol << " - " << name << " ===" << endl;
-    cout << "Total days of data: " << dates.size() << endl;
+    cout << "Total days of data: " << bars.size() << endl;
     
-    if (dates.size() > 0) {
-        cout << "Date range: " << dates[0] << " to " << dates[dates.size()-1] << endl;
-        cout << "Latest close: $" << closePrices[closePrices.size()-1] << endl;
+    if (bars.size() > 0) {
+        cout << "Date range: " << getDate(0) << " to " << getDate(bars.size() - 1) << endl;
+        cout << "Latest close: $" << bars.getClose(bars.size() - 1) << endl;
     }
 }
 
 // Display recent data
 void Stock::displayRecentData(int numDays) const {
-    if (dates.size() == 0) {
+    if (bars.size() == 0) {
         cout << "No data available." << endl;
         return;
     }
     
-    int start = max(0, (int)dates.size() - numDays);
+    int start = max(0, bars.size() - numDays);
     
     cout << "\nRecent " << numDays << " days:" << endl;
     cout << "Date\t\tOpen\tHigh\tLow\tClose\tVolume" << endl;
     cout << "--------------------------------------------------------" << endl;
     
-    for (int i = start; i < dates.size(); i++) {
-        cout << dates[i] << "\t"
-             << openPrices[i] << "\t"
-             << highPrices[i] << "\t"
-             << lowPrices[i] << "\t"
-             << closePrices[i] << "\t"
-             << volumes[i] << endl;
+    for (int i = start; i < bars.size(); i++) {
+        cout << getDate(i) << "\t"
+             << bars.getOpen(i) << "\t"
+             << bars.getHigh(i) << "\t"
+             << bars.getLow(i) << "\t"
+             << bars.getClose(i) << "\t"
+             << bars.getVolume(i) << endl;
     }
 }
 
+// Drop cached indicators
+void Stock::resetIndicators() {
+    indicators.clear();
+    for (int i = 0; i < NUM_STANDARD_INDICATORS; i++) {
+        standardSeries[i].store(nullptr, memory_order_relaxed);
+    }
+    bumpRevision();
+}
+
+void Stock::bumpRevision() {
+    revision = nextRevision.fetch_add(1, memory_order_relaxed);
+}
+
+// Helper: registry key of each standard indicator
+IndicatorKey Stock::standardKey(StandardIndicator which) {
+    switch (which) {
+        case SMA_20:           return {"SMA", {20}};
+        case SMA_50:           return {"SMA", {50}};
+        case RSI_14:           return {"RSI", {14}};
+        case MACD_LINE:        return {"MACD", {12, 26}};
+        case MACD_SIGNAL_LINE: return {"MACD_SIGNAL", {12, 26, 9}};
+        case MACD_HISTOGRAM:   return {"MACD_HIST", {12, 26, 9}};
+        case BOLLINGER_UPPER:  return {"BB_UPPER", {20, 2.0}};
+        case BOLLINGER_MIDDLE: return {"BB_MIDDLE", {20}};
+        case BOLLINGER_LOWER:  return {"BB_LOWER", {20, 2.0}};
+        default:               return {"MOMENTUM", {10}};
+    }
+}
+
+// Helper: standard series, computed on first use.
+// Racing threads end up with the same series since the registry keeps the first insert.
+const Series* Stock::standard(StandardIndicator which) const {
+    const Series* series = standardSeries[which].load(memory_order_acquire);
+    
+    if (series == nullptr) {
+        IndicatorKey key = standardKey(which);
+        series = &getIndicator(key.name, key.params);
+        standardSeries[which].store(series, memory_order_release);
+    }
+    
+    return series;
+}
+
+void Stock::setStandard(StandardIndicator which, const Series& series) {
+    standardSeries[which].store(&series, memory_order_release);
+}
+
+// Helper: value of a series at index
+double Stock::valueAt(const Series* series, int index) {
+    if (index >= 0 && index < series->size()) {
+        return (*series)[index];
+    }
+    return 0.0;
+}
+
+// Any indicator by name and parameters
+const Series& Stock::getIndicator(const string& name, const vector<double>& params) const {
+    string message;
+    return getIndicator(name, params, message);
+}
+
+const Series& Stock::getIndicator(const string& name, const vector<double>& params, string& message) const {
+    message.clear();
+    return indicators.get(name, params, bars.getCloses(), message);
+}
+
+int Stock::getIndicatorFirstValid(const string& name, const vector<double>& params) const {
+    getIndicator(name, params);
+    return indicators.firstValid(name, params);
+}
+
 // Calculate Simple Moving Average
 void Stock::calculateSMA(int period) {
-    vector<double>* targetVector;
+    const Series& values = getIndicator("SMA", {(double)period});
     
-    // Decide which vector to fill
+    // 20 and 50 back the fixed getters
     if (period == 20) {
-        targetVector = &sma20;
+        setStandard(SMA_20, values);
     } else if (period == 50) {
-        targetVector = &sma50;
-    } else {
-        cout << "Error: SMA period " << period << " not supported" << endl;
-        return;
-    }
-    
-    targetVector->clear();
-    
-    // Calculate SMA for each day
-    for (int i = 0; i < closePrices.size(); i++) {
-        if (i < period - 1) {
-            // Not enough data yet, store 0 or -1 as placeholder
-            targetVector->push_back(0.0);
-        } else {
-            // Calculate average of last 'period' days
-            double sum = 0.0;
-            for (int j = i - period + 1; j <= i; j++) {
-                sum += closePrices[j];
-            }
-            double sma = sum / period;
-            targetVector->push_back(sma);
-        }
+        setStandard(SMA_50, values);
     }
 }
 
@@ -174,262 +371,89 @@ void Stock::calculateAllIndicators() {
     cout << "✓ Indicators calculated!" << endl;
 }
 
+// Compute the standard indicator set without printing
+void Stock::precomputeIndicators() {
+    for (int i = 0; i < NUM_STANDARD_INDICATORS; i++) {
+        standard(static_cast<StandardIndicator>(i));
+    }
+}
+
+bool Stock::isEagerIndicators() {
+    return eagerIndicators;
+}
+
 // Get SMA values
 double Stock::getSMA20(int index) const {
-    if (index >= 0 && index < sma20.size()) {
-        return sma20[index];
-    }
-    return 0.0;
+    return valueAt(standard(SMA_20), index);
+}
+
+double Stock::getSMA50(int index) const {
+    return valueAt(standard(SMA_50), index);
 }
 
 // Calculate Exponential Moving Average
 void Stock::calculateEMA(int period) {
-    vector<double>* targetVector;
-    
-    if (period == 12) {
-        targetVector = &ema12;
-    } else if (period == 26) {
-        targetVector = &ema26;
-    } else {
-        return;
-    }
-    
-    targetVector->clear();
-    
-    double multiplier = 2.0 / (period + 1);
-    
-    for (int i = 0; i < closePrices.size(); i++) {
-        if (i < period - 1) {
-            targetVector->push_back(0.0);
-        } else if (i == period - 1) {
-            // First EMA = SMA
-            double sum = 0.0;
-            for (int j = 0; j < period; j++) {
-                sum += closePrices[i - period + 1 + j];
-            }
-            targetVector->push_back(sum / period);
-        } else {
-            // EMA = (Close * multiplier) + (EMA_prev * (1 - multiplier))
-            double ema = (closePrices[i] * multiplier) + ((*targetVector)[i-1] * (1 - multiplier));
-            targetVector->push_back(ema);
-        }
-    }
+    getIndicator("EMA", {(double)period});
 }
 
-// Calculate MACD
+// Calculate MACD (12/26 EMAs, 9-day signal)
 void Stock::calculateMACD() {
-    macd.clear();
-    macdSignal.clear();
-    macdHistogram.clear();
-    
-    // Calculate MACD Line = EMA12 - EMA26
-    for (int i = 0; i < closePrices.size(); i++) {
-        if (i < 25) {  // Need 26 days for EMA26
-            macd.push_back(0.0);
-        } else {
-            double macdValue = ema12[i] - ema26[i];
-            macd.push_back(macdValue);
-        }
-    }
-    
-    // Calculate Signal Line = 9-day EMA of MACD
-    double multiplier = 2.0 / (9 + 1);
-    
-    for (int i = 0; i < macd.size(); i++) {
-        if (i < 33) {  // Need 26 + 9 - 1 = 34 days
-            macdSignal.push_back(0.0);
-        } else if (i == 33) {
-            // First signal = SMA of MACD
-            double sum = 0.0;
-            for (int j = 0; j < 9; j++) {
-                sum += macd[i - 8 + j];
-            }
-            macdSignal.push_back(sum / 9);
-        } else {
-            // Signal EMA
-            double signal = (macd[i] * multiplier) + (macdSignal[i-1] * (1 - multiplier));
-            macdSignal.push_back(signal);
-        }
-    }
-    
-    // Calculate Histogram = MACD - Signal
-    for (int i = 0; i < macd.size(); i++) {
-        if (macdSignal[i] == 0.0) {
-            macdHistogram.push_back(0.0);
-        } else {
-            macdHistogram.push_back(macd[i] - macdSignal[i]);
-        }
-    }
+    setStandard(MACD_LINE, getIndicator("MACD", {12, 26}));
+    setStandard(MACD_SIGNAL_LINE, getIndicator("MACD_SIGNAL", {12, 26, 9}));
+    setStandard(MACD_HISTOGRAM, getIndicator("MACD_HIST", {12, 26, 9}));
 }
 
 double Stock::getMACD(int index) const {
-    if (index >= 0 && index < macd.size()) {
-        return macd[index];
-    }
-    return 0.0;
+    return valueAt(standard(MACD_LINE), index);
 }
 
 double Stock::getMACDSignal(int index) const {
-    if (index >= 0 && index < macdSignal.size()) {
-        return macdSignal[index];
-    }
-    return 0.0;
+    return valueAt(standard(MACD_SIGNAL_LINE), index);
 }
 
 double Stock::getMACDHistogram(int index) const {
-    if (index >= 0 && index < macdHistogram.size()) {
-        return macdHistogram[index];
-    }
-    return 0.0;
+    return valueAt(standard(MACD_HISTOGRAM), index);
 }
 
-// Calculate Bollinger Bands
+// Calculate Bollinger Bands (middle band shares the SMA series)
 void Stock::calculateBollingerBands(int period, double numStdDev) {
-    bollingerUpper.clear();
-    bollingerMiddle.clear();
-    bollingerLower.clear();
-    
-    for (int i = 0; i < closePrices.size(); i++) {
-        if (i < period - 1) {
-            bollingerUpper.push_back(0.0);
-            bollingerMiddle.push_back(0.0);
-            bollingerLower.push_back(0.0);
-        } else {
-            // Calculate SMA (middle band)
-            double sum = 0.0;
-            for (int j = i - period + 1; j <= i; j++) {
-                sum += closePrices[j];
-            }
-            double sma = sum / period;
-            
-            // Calculate standard deviation
-            double variance = 0.0;
-            for (int j = i - period + 1; j <= i; j++) {
-                double diff = closePrices[j] - sma;
-                variance += diff * diff;
-            }
-            double stdDev = sqrt(variance / period);
-            
-            // Calculate bands
-            bollingerMiddle.push_back(sma);
-            bollingerUpper.push_back(sma + (numStdDev * stdDev));
-            bollingerLower.push_back(sma - (numStdDev * stdDev));
-        }
-    }
+    setStandard(BOLLINGER_MIDDLE, getIndicator("BB_MIDDLE", {(double)period}));
+    setStandard(BOLLINGER_UPPER, getIndicator("BB_UPPER", {(double)period, numStdDev}));
+    setStandard(BOLLINGER_LOWER, getIndicator("BB_LOWER", {(double)period, numStdDev}));
 }
 
 double Stock::getBollingerUpper(int index) const {
-    if (index >= 0 && index < bollingerUpper.size()) {
-        return bollingerUpper[index];
-    }
-    return 0.0;
+    return valueAt(standard(BOLLINGER_UPPER), index);
 }
 
 double Stock::getBollingerMiddle(int index) const {
-    if (index >= 0 && index < bollingerMiddle.size()) {
-        return bollingerMiddle[index];
-    }
-    return 0.0;
+    return valueAt(standard(BOLLINGER_MIDDLE), index);
 }
 
 double Stock::getBollingerLower(int index) const {
-    if (index >= 0 && index < bollingerLower.size()) {
-        return bollingerLower[index];
-    }
-    return 0.0;
+    return valueAt(standard(BOLLINGER_LOWER), index);
 }
 
 // Calculate Momentum
 void Stock::calculateMomentum(int period) {
-    momentum.clear();
-    
-    for (int i = 0; i < closePrices.size(); i++) {
-        if (i < period) {
-            momentum.push_back(0.0);
-        } else {
-            double currentPrice = closePrices[i];
-            double oldPrice = closePrices[i - period];
-            double mom = ((currentPrice - oldPrice) / oldPrice) * 100.0;
-            momentum.push_back(mom);
-        }
-    }
+    setStandard(MOMENTUM_10, getIndicator("MOMENTUM", {(double)period}));
 }
 
 double Stock::getMomentum(int index) const {
-    if (index >= 0 && index < momentum.size()) {
-        return momentum[index];
-    }
-
-double Stock::getSMA50(int index) const {
-    if (index >= 0 && index < sma50.size()) {
-        return sma50[index];
-    }
-    return 0.0;
+    return valueAt(standard(MOMENTUM_10), index);
 }
 
 // Calculate RSI (Relative Strength Index)
 void Stock::calculateRSI(int period) {
-    rsi.clear();
-    
-    if (closePrices.size() < period + 1) {
+    if (bars.size() < period + 1) {
         cout << "Not enough data for RSI calculation" << endl;
-        return;
     }
     
-    // First day has no RSI
-    rsi.push_back(0.0);
-    
-    // Calculate gains and losses
-    vector<double> gains;
-    vector<double> losses;
-    
-    for (int i = 1; i < closePrices.size(); i++) {
-        double change = closePrices[i] - closePrices[i-1];
-        
-        if (change > 0) {
-            gains.push_back(change);
-            losses.push_back(0.0);
-        } else {
-            gains.push_back(0.0);
-            losses.push_back(abs(change));
-        }
-    }
-    
-    // Calculate RSI for each day
-    for (int i = 0; i < gains.size(); i++) {
-        if (i < period - 1) {
-            // Not enough data yet
-            rsi.push_back(0.0);
-        } else {
-            // Calculate average gain and loss over period
-            double sumGain = 0.0;
-            double sumLoss = 0.0;
-            
-            for (int j = i - period + 1; j <= i; j++) {
-                sumGain += gains[j];
-                sumLoss += losses[j];
-            }
-            
-            double avgGain = sumGain / period;
-            double avgLoss = sumLoss / period;
-            
-            // Calculate RSI
-            if (avgLoss == 0.0) {
-                rsi.push_back(100.0);
-            } else {
-                double rs = avgGain / avgLoss;
-                double rsiValue = 100.0 - (100.0 / (1.0 + rs));
-                rsi.push_back(rsiValue);
-            }
-        }
-    }
+    setStandard(RSI_14, getIndicator("RSI", {(double)period}));
 }
 
 double Stock::getRSI(int index) const {
-    if (index >= 0 && index < rsi.size()) {
-        return rsi[index];
-    }
-    return 0.0;
+    return valueAt(standard(RSI_14), index);
 }
 
 // Debug RSI calculation for specific index
@@ -443,6 +467,7 @@ void Stock::debugRSI(int index) const {
     cout << "Last 14 days of prices and changes:" << endl;
     cout << "Day\tClose\tChange\tGain\tLoss" << endl;
     
+    const Series& closePrices = bars.getCloses();
     double totalGain = 0.0;
     double totalLoss = 0.0;
     
@@ -0,0 +1,101 @@
+// StockLoader.cpp
+#include "../include/StockLoader.h"
+#include "../include/ThreadPool.h"
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+using namespace std;
+
+// Find CSV files
+vector<string> StockLoader::findCSVFiles(const string& directory) {
+    vector<string> files;
+    error_code error;
+    
+    for (const auto& entry : filesystem::directory_iterator(directory, error)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".csv") {
+            files.push_back(entry.path().string());
+        }
+    }
+    
+    sort(files.begin(), files.end());
+    return files;
+}
+
+bool StockLoader::isDirectory(const string& path) {
+    error_code error;
+    return filesystem::is_directory(path, error);
+}
+
+// Load a whole directory
+LoadReport StockLoader::loadDirectory(const string& directory, StockRegistry& stocks,
+                                      int numThreads, bool showProgress) {
+    auto startTime = chrono::steady_clock::now();
+    
+    LoadReport report;
+    report.loaded = 0;
+    report.failed = 0;
+    report.seconds = 0.0;
+    
+    vector<string> files = findCSVFiles(directory);
+    int numFiles = files.size();
+    
+    // One slot per file so workers never share anything but the counter
+    vector<Stock*> results(numFiles, nullptr);
+    vector<string> messages(numFiles);
+    atomic<int> finished(0);
+    
+    {
+        ThreadPool pool(min(numThreads > 0 ? numThreads : ThreadPool::defaultThreads(), max(1, numFiles)));
+        
+        for (int i = 0; i < numFiles; i++) {
+            pool.submit([&, i] {
+                string symbol = filesystem::path(files[i]).stem().string();
+                Stock* stock = new Stock(symbol, symbol);
+                
+                if (stock->loadFromCSV(files[i], messages[i])) {
+                    if (Stock::isEagerIndicators()) {
+                        stock->precomputeIndicators();
+                    }
+                    results[i] = stock;
+                } else {
+                    delete stock;
+                }
+                
+                finished.fetch_add(1, memory_order_relaxed);
+            });
+        }
+        
+        // Only this thread writes to cout
+        while (showProgress && finished.load(memory_order_relaxed) < numFiles) {
+            cout << "\rLoading... " << finished.load(memory_order_relaxed) << "/" << numFiles << flush;
+            this_thread::sleep_for(chrono::milliseconds(20));
+        }
+        
+        pool.waitAll();
+    }
+    
+    if (showProgress && numFiles > 0) {
+        cout << "\rLoading... " << numFiles << "/" << numFiles << endl;
+    }
+    
+    // Register on the calling thread
+    for (int i = 0; i < numFiles; i++) {
+        if (!messages[i].empty()) {
+            report.messages.push_back(messages[i]);
+        }
+        
+        if (results[i] == nullptr) {
+            report.failed++;
+            continue;
+        }
+        
+        stocks.add(results[i]);
+        report.loaded++;
+    }
+    
+    report.seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+    return report;
+}
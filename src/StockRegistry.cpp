@@ -0,0 +1,37 @@
+// StockRegistry.cpp
+#include "../include/StockRegistry.h"
+#include <algorithm>
+
+using namespace std;
+
+// Constructor
+StockRegistry::StockRegistry() {
+}
+
+StockRegistry::~StockRegistry() {
+    for (Stock* stock : sorted) {
+        delete stock;
+    }
+}
+
+void StockRegistry::add(Stock* stock) {
+    int id = SymbolTable::global().intern(stock->getSymbol());
+    if (id >= (int)byId.size()) {
+        byId.resize(id + 1, nullptr);
+    }
+    
+    auto position = lower_bound(sorted.begin(), sorted.end(), stock,
+                                [](const Stock* a, const Stock* b) { return a->getSymbol() < b->getSymbol(); });
+    if (byId[id] != nullptr) {
+        // Same symbol: take over its slot in the listing
+        delete byId[id];
+        *position = stock;
+    } else {
+        sorted.insert(position, stock);
+    }
+    byId[id] = stock;
+}
+
+Stock* StockRegistry::find(const string& symbol) const {
+    return get(SymbolTable::global().find(symbol));
+}
\ No newline at end of file
@@ -1,11 +1,35 @@
 // Strategy.cpp
 #include "../include/Strategy.h"
+#include <algorithm>
 
 using namespace std;
 
 // Base Strategy
 Strategy::Strategy(string strategyName) {
     name = strategyName;
+    signalsRevision = 0;
+}
+
+// Generic signals: ask the per-day rules
+void Strategy::generateSignals(Stock* stock, vector<int8_t>& signals) {
+    int dataSize = stock->getDataSize();
+    signals.assign(dataSize, SIGNAL_HOLD);
+    
+    prepare(stock);
+    for (int day = 0; day < dataSize; day++) {
+        int8_t flags = SIGNAL_HOLD;
+        if (shouldBuy(stock, day, false)) flags |= SIGNAL_BUY;
+        if (shouldSell(stock, day, true)) flags |= SIGNAL_SELL;
+        signals[day] = flags;
+    }
+}
+
+const vector<int8_t>& Strategy::getSignals(Stock* stock) {
+    if (stock->getRevision() != signalsRevision) {
+        generateSignals(stock, cachedSignals);
+        signalsRevision = stock->getRevision();
+    }
+    return cachedSignals;
 }
 
 string Strategy::getName() const {
@@ -13,61 +37,138 @@ string Strategy::getName() const {
 }
 
 // RSI Strategy
-RSIStrategy::RSIStrategy() : Strategy("RSI Strategy") {}
+RSIStrategy::RSIStrategy(int rsiPeriod, double oversoldLevel, double overboughtLevel) : Strategy("RSI Strategy") {
+    period = rsiPeriod;
+    oversold = oversoldLevel;
+    overbought = overboughtLevel;
+    preparedRevision = 0;
+    rsiValues = nullptr;
+}
+
+void RSIStrategy::prepare(const Stock* stock) {
+    preparedRevision = stock->getRevision();
+    rsiValues = &stock->getIndicator("RSI", {(double)period});
+}
+
+double RSIStrategy::rsiAt(const Stock* stock, int day) {
+    if (stock->getRevision() != preparedRevision) {
+        prepare(stock);
+    }
+    if (day >= 0 && day < (int)rsiValues->size()) {
+        return (*rsiValues)[day];
+    }
+    return 0.0;
+}
 
 bool RSIStrategy::shouldBuy(Stock* stock, int day, bool currentlyHolding) {
     if (currentlyHolding) return false;
     
-    double rsi = stock->getRSI(day);
-    return (rsi > 0 && rsi < 30);  // Oversold
+    double rsi = rsiAt(stock, day);
+    return (rsi > 0 && rsi < oversold);  // Oversold
 }
 
 bool RSIStrategy::shouldSell(Stock* stock, int day, bool currentlyHolding) {
     if (!currentlyHolding) return false;
     
-    double rsi = stock->getRSI(day);
-    return (rsi > 70);  // Overbought
+    double rsi = rsiAt(stock, day);
+    return (rsi > overbought);  // Overbought
+}
+
+// One pass over the RSI column
+void RSIStrategy::generateSignals(Stock* stock, vector<int8_t>& signals) {
+    prepare(stock);
+    
+    const Series& rsi = *rsiValues;
+    int dataSize = min(stock->getDataSize(), (int)rsi.size());
+    signals.assign(stock->getDataSize(), SIGNAL_HOLD);
+    
+    for (int day = 0; day < dataSize; day++) {
+        double value = rsi[day];
+        int8_t buy = (value > 0 && value < oversold) ? SIGNAL_BUY : SIGNAL_HOLD;
+        int8_t sell = (value > overbought) ? SIGNAL_SELL : SIGNAL_HOLD;
+        signals[day] = buy | sell;
+    }
 }
 
 // Moving Average Crossover Strategy
-MAStrategy::MAStrategy() : Strategy("Moving Average Crossover") {
-    previousCrossAbove = false;
+MAStrategy::MAStrategy(int fast, int slow) : Strategy("Moving Average Crossover") {
+    fastPeriod = fast;
+    slowPeriod = slow;
+    preparedRevision = 0;
+    fastValues = nullptr;
+    slowValues = nullptr;
+}
+
+void MAStrategy::prepare(const Stock* stock) {
+    preparedRevision = stock->getRevision();
+    fastValues = &stock->getIndicator("SMA", {(double)fastPeriod});
+    slowValues = &stock->getIndicator("SMA", {(double)slowPeriod});
+}
+
+void MAStrategy::ensurePrepared(const Stock* stock) {
+    if (stock->getRevision() != preparedRevision) {
+        prepare(stock);
+    }
 }
 
 bool MAStrategy::shouldBuy(Stock* stock, int day, bool currentlyHolding) {
     if (currentlyHolding) return false;
-    if (day < 50) return false;  // Need enough data for SMA50
+    if (day < slowPeriod || day < 1) return false;  // Need enough data for the slow SMA
     
-    double sma20 = stock->getSMA20(day);
-    double sma50 = stock->getSMA50(day);
-    double prevSma20 = stock->getSMA20(day - 1);
-    double prevSma50 = stock->getSMA50(day - 1);
+    ensurePrepared(stock);
+    if (day >= (int)fastValues->size() || day >= (int)slowValues->size()) return false;
     
-    if (sma20 == 0 || sma50 == 0) return false;
+    double fast = (*fastValues)[day];
+    double slow = (*slowValues)[day];
+    double prevFast = (*fastValues)[day - 1];
+    double prevSlow = (*slowValues)[day - 1];
     
-    // Crossover: SMA20 was below SMA50, now above
-    bool crossedAbove = (prevSma20 <= prevSma50) && (sma20 > sma50);
+    if (fast == 0 || slow == 0) return false;
+    
+    // Crossover: fast SMA was below slow SMA, now above
+    bool crossedAbove = (prevFast <= prevSlow) && (fast > slow);
     
     return crossedAbove;
 }
 
 bool MAStrategy::shouldSell(Stock* stock, int day, bool currentlyHolding) {
     if (!currentlyHolding) return false;
-    if (day < 50) return false;
+    if (day < slowPeriod || day < 1) return false;
+    
+    ensurePrepared(stock);
+    if (day >= (int)fastValues->size() || day >= (int)slowValues->size()) return false;
     
-    double sma20 = stock->getSMA20(day);
-    double sma50 = stock->getSMA50(day);
-    double prevSma20 = stock->getSMA20(day - 1);
-    double prevSma50 = stock->getSMA50(day - 1);
+    double fast = (*fastValues)[day];
+    double slow = (*slowValues)[day];
+    double prevFast = (*fastValues)[day - 1];
+    double prevSlow = (*slowValues)[day - 1];
     
-    if (sma20 == 0 || sma50 == 0) return false;
+    if (fast == 0 || slow == 0) return false;
     
-    // Crossover: SMA20 was above SMA50, now below
-    bool crossedBelow = (prevSma20 >= prevSma50) && (sma20 < sma50);
+    // Crossover: fast SMA was above slow SMA, now below
+    bool crossedBelow = (prevFast >= prevSlow) && (fast < slow);
     
     return crossedBelow;
 }
 
+// One pass over both SMA columns
+void MAStrategy::generateSignals(Stock* stock, vector<int8_t>& signals) {
+    prepare(stock);
+    
+    const Series& fast = *fastValues;
+    const Series& slow = *slowValues;
+    int dataSize = min(stock->getDataSize(), (int)min(fast.size(), slow.size()));
+    signals.assign(stock->getDataSize(), SIGNAL_HOLD);
+    
+    for (int day = max(slowPeriod, 1); day < dataSize; day++) {
+        if (fast[day] == 0 || slow[day] == 0) continue;
+        
+        bool crossedAbove = (fast[day - 1] <= slow[day - 1]) && (fast[day] > slow[day]);
+        bool crossedBelow = (fast[day - 1] >= slow[day - 1]) && (fast[day] < slow[day]);
+        signals[day] = (crossedAbove ? SIGNAL_BUY : SIGNAL_HOLD) | (crossedBelow ? SIGNAL_SELL : SIGNAL_HOLD);
+    }
+}
+
 // Buy and Hold Strategy
 BuyHoldStrategy::BuyHoldStrategy() : Strategy("Buy and Hold") {}
 
@@ -79,4 +180,13 @@ bool BuyHoldStrategy::shouldBuy(Stock* stock, int day, bool currentlyHolding) {
 bool BuyHoldStrategy::shouldSell(Stock* stock, int day, bool currentlyHolding) {
     // Never sell
     return false;
+}
+
+void BuyHoldStrategy::generateSignals(Stock* stock, vector<int8_t>& signals) {
+    int dataSize = stock->getDataSize();
+    signals.assign(dataSize, SIGNAL_HOLD);
+    
+    for (int day = 50; day < dataSize; day++) {
+        signals[day] = SIGNAL_BUY;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+// SymbolTable.cpp
+#include "../include/SymbolTable.h"
+#include <functional>
+
+using namespace std;
+
+static const size_t INITIAL_SLOTS = 64;
+
+// Constructor
+SymbolTable::SymbolTable() {
+    slots.assign(INITIAL_SLOTS, -1);
+}
+
+size_t SymbolTable::probe(const string& symbol, size_t hash) const {
+    size_t mask = slots.size() - 1;
+    size_t slot = hash & mask;
+    while (slots[slot] >= 0) {
+        int id = slots[slot];
+        if (hashes[id] == hash && names[id] == symbol) break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void SymbolTable::grow() {
+    slots.assign(slots.size() * 2, -1);
+    size_t mask = slots.size() - 1;
+    for (int id = 0; id < (int)names.size(); id++) {
+        size_t slot = hashes[id] & mask;
+        while (slots[slot] >= 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = id;
+    }
+}
+
+int SymbolTable::intern(const string& symbol) {
+    size_t hash = std::hash<string>()(symbol);
+    size_t slot = probe(symbol, hash);
+    if (slots[slot] >= 0) {
+        return slots[slot];
+    }
+    
+    int id = names.size();
+    names.push_back(symbol);
+    hashes.push_back(hash);
+    slots[slot] = id;
+    
+    // Keep the table at most half full so probe runs stay short
+    if (names.size() * 2 > slots.size()) {
+        grow();
+    }
+    return id;
+}
+
+int SymbolTable::find(const string& symbol) const {
+    return slots[probe(symbol, std::hash<string>()(symbol))];
+}
+
+void SymbolTable::clear() {
+    names.clear();
+    hashes.clear();
+    slots.assign(INITIAL_SLOTS, -1);
+}
+
+SymbolTable& SymbolTable::global() {
+    static SymbolTable table;
+    return table;
+}
\ No newline at end of file
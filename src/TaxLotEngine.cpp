@@ -0,0 +1,316 @@
+// TaxLotEngine.cpp
+#include "../include/TaxLotEngine.h"
+#include "../include/DateUtil.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+static const int WASH_SALE_DAYS = 30;
+static const int LONG_TERM_DAYS = 365;
+static const int MAX_GAIN_ROWS = 50;
+
+const char* lotMethodName(LotMethod method) {
+    switch (method) {
+        case LOT_FIFO: return "FIFO";
+        case LOT_LIFO: return "LIFO";
+        default: return "Specific lots";
+    }
+}
+
+// Constructor
+TaxLotEngine::TaxLotEngine(LotMethod reliefMethod) {
+    method = reliefMethod;
+    ledger = nullptr;
+}
+
+void TaxLotEngine::rebuild(const Ledger& history, const map<int, int>& lotChoices) {
+    ledger = &history;
+    int rows = history.size();
+    
+    lots.assign(history.symbolIdLimit(), deque<TaxLot>());
+    gains.clear();
+    replacementUsed.assign(rows, 0);
+    pending.clear();
+    
+    vector<int> window;
+    for (int row = 0; row < rows; row++) {
+        int symbolId = history.getSymbolId(row);
+        int quantity = history.getQuantity(row);
+        deque<TaxLot>& open = lots[symbolId];
+        
+        if (history.getSide(row) == TRADE_BUY) {
+            if (quantity > 0) openLots(row);
+            continue;
+        }
+        
+        int firstGain = gains.size();
+        int remaining = quantity;
+        
+        // The chosen buy goes first (all of its lots)
+        if (method == LOT_SPECIFIC) {
+            auto choice = lotChoices.find(row);
+            if (choice != lotChoices.end()) {
+                TaxLot* lot;
+                while (remaining > 0 && (lot = findLot(symbolId, choice->second)) != nullptr) {
+                    remaining -= closeShares(*lot, row, remaining);
+                }
+                trimEmpty(open);
+            }
+        }
+        
+        // Then oldest (or newest) first
+        while (remaining > 0 && !open.empty()) {
+            TaxLot& lot = (method == LOT_LIFO) ? open.back() : open.front();
+            remaining -= closeShares(lot, row, remaining);
+            trimEmpty(open);
+        }
+        
+        applyWashSales(row, firstGain, window);
+    }
+}
+
+// Open lots of a symbol are in row order, so a buy's lots are found by
+// binary search. Returns the first one with shares left.
+TaxLot* TaxLotEngine::findLot(int symbolId, int row) {
+    deque<TaxLot>& open = lots[symbolId];
+    auto it = lower_bound(open.begin(), open.end(), row,
+                          [](const TaxLot& lot, int r) { return lot.row < r; });
+    for (; it != open.end() && it->row == row; ++it) {
+        if (it->remaining > 0) return &*it;
+    }
+    return nullptr;
+}
+
+// Open a buy: replacement lots recorded by earlier wash sales first,
+// then the rest of the shares at the buy price
+void TaxLotEngine::openLots(int row) {
+    deque<TaxLot>& open = lots[ledger->getSymbolId(row)];
+    int date = ledger->getDate(row);
+    double price = ledger->getPrice(row);
+    int plain = ledger->getQuantity(row);
+    
+    auto range = pending.equal_range(row);
+    for (auto it = range.first; it != range.second; ++it) {
+        const WashReplacement& wash = it->second;
+        TaxLot lot = {row, date - wash.heldDays, wash.shares, price + wash.lossPerShare, true};
+        open.push_back(lot);
+        plain -= wash.shares;
+    }
+    pending.erase(range.first, range.second);
+    
+    if (plain > 0) {
+        TaxLot lot = {row, date, plain, price, false};
+        open.push_back(lot);
+    }
+}
+
+// The lot of a replayed buy that hasn't absorbed a wash sale (end() if
+// it was emptied and trimmed)
+deque<TaxLot>::iterator TaxLotEngine::findPlainLot(int symbolId, int row) {
+    deque<TaxLot>& open = lots[symbolId];
+    auto it = lower_bound(open.begin(), open.end(), row,
+                          [](const TaxLot& lot, int r) { return lot.row < r; });
+    for (; it != open.end() && it->row == row; ++it) {
+        if (!it->replacement) return it;
+    }
+    return open.end();
+}
+
+// Split replacement shares off a buy's plain lot. The new lot goes just
+// before it, keeping the deque in row order.
+void TaxLotEngine::splitReplacement(int symbolId, deque<TaxLot>::iterator plain, const WashReplacement& wash) {
+    TaxLot lot = {plain->row, plain->date - wash.heldDays, wash.shares,
+                  plain->costPerShare + wash.lossPerShare, true};
+    plain->remaining -= wash.shares;
+    
+    deque<TaxLot>& open = lots[symbolId];
+    open.insert(plain, lot);
+    trimEmpty(open);
+}
+
+// Drop emptied lots from both ends (ones in the middle wait their turn)
+void TaxLotEngine::trimEmpty(deque<TaxLot>& open) {
+    while (!open.empty() && open.front().remaining == 0) {
+        open.pop_front();
+    }
+    while (!open.empty() && open.back().remaining == 0) {
+        open.pop_back();
+    }
+}
+
+// Close up to `quantity` shares of a lot, returns how many
+int TaxLotEngine::closeShares(TaxLot& lot, int sellRow, int quantity) {
+    int shares = min(lot.remaining, quantity);
+    double price = ledger->getPrice(sellRow);
+    int sellDate = ledger->getDate(sellRow);
+    
+    RealizedGain gain;
+    gain.sellRow = sellRow;
+    gain.lotRow = lot.row;
+    gain.quantity = shares;
+    gain.buyDate = lot.date;
+    gain.sellDate = sellDate;
+    gain.costBasis = shares * lot.costPerShare;
+    gain.proceeds = shares * price;
+    gain.gain = gain.proceeds - gain.costBasis;
+    gain.disallowed = 0.0;
+    gain.longTerm = (sellDate - lot.date) > LONG_TERM_DAYS;
+    gains.push_back(gain);
+    
+    lot.remaining -= shares;
+    return shares;
+}
+
+// For each loss of this sell, find other buys of the symbol within 30
+// days and defer the loss into their cost, share for share. The matched
+// shares become a lot of their own with the extra basis, and their
+// holding period starts earlier by as long as the washed shares were
+// held. They are split off now for buys already replayed and recorded
+// in `pending` for later buys.
+void TaxLotEngine::applyWashSales(int sellRow, int firstGain, vector<int>& window) {
+    int symbolId = ledger->getSymbolId(sellRow);
+    int sellDate = ledger->getDate(sellRow);
+    bool windowLoaded = false;
+    
+    for (size_t i = firstGain; i < gains.size(); i++) {
+        RealizedGain& g = gains[i];
+        if (g.gain >= 0.0) continue;
+        
+        if (!windowLoaded) {
+            ledger->query(symbolId, sellDate - WASH_SALE_DAYS, sellDate + WASH_SALE_DAYS, window);
+            windowLoaded = true;
+        }
+        
+        double lossPerShare = -g.gain / g.quantity;
+        int unmatched = g.quantity;
+        for (int row : window) {
+            if (unmatched == 0) break;
+            if (ledger->getSide(row) != TRADE_BUY || row == g.lotRow) continue;
+            
+            // Unsold shares not yet used as a replacement
+            deque<TaxLot>::iterator plain = lots[symbolId].end();
+            int available;
+            if (row < sellRow) {
+                plain = findPlainLot(symbolId, row);
+                available = (plain != lots[symbolId].end()) ? plain->remaining : 0;
+            } else {
+                available = ledger->getQuantity(row) - replacementUsed[row];
+            }
+            int shares = min(available, unmatched);
+            if (shares <= 0) continue;
+            
+            unmatched -= shares;
+            g.disallowed += shares * lossPerShare;
+            
+            WashReplacement wash = {shares, lossPerShare, g.sellDate - g.buyDate};
+            if (row < sellRow) {
+                splitReplacement(symbolId, plain, wash);
+            } else {
+                replacementUsed[row] += shares;
+                pending.insert(make_pair(row, wash));
+            }
+        }
+    }
+}
+
+vector<TaxLot> TaxLotEngine::getOpenLots(const string& symbol) const {
+    vector<TaxLot> result;
+    int symbolId = (ledger != nullptr) ? SymbolTable::global().find(symbol) : -1;
+    if (symbolId < 0 || symbolId >= (int)lots.size()) return result;
+    
+    for (const TaxLot& lot : lots[symbolId]) {
+        if (lot.remaining > 0) {
+            result.push_back(lot);
+        }
+    }
+    return result;
+}
+
+double TaxLotEngine::getShortTermGain() const {
+    double total = 0.0;
+    for (const RealizedGain& g : gains) {
+        if (!g.longTerm) total += g.gain + g.disallowed;
+    }
+    return total;
+}
+
+double TaxLotEngine::getLongTermGain() const {
+    double total = 0.0;
+    for (const RealizedGain& g : gains) {
+        if (g.longTerm) total += g.gain + g.disallowed;
+    }
+    return total;
+}
+
+double TaxLotEngine::getDisallowedLoss() const {
+    double total = 0.0;
+    for (const RealizedGain& g : gains) {
+        total += g.disallowed;
+    }
+    return total;
+}
+
+void TaxLotEngine::displayOpenLots() const {
+    cout << "\n=== Open Tax Lots (" << lotMethodName(method) << ") ===" << endl;
+    if (ledger == nullptr) return;
+    
+    // Symbols in name order
+    const SymbolTable& symbols = SymbolTable::global();
+    vector<int> order;
+    for (int id = 0; id < (int)lots.size(); id++) {
+        if (!lots[id].empty()) order.push_back(id);
+    }
+    sort(order.begin(), order.end(),
+         [&symbols](int a, int b) { return symbols.name(a) < symbols.name(b); });
+    
+    if (order.empty()) {
+        cout << "No open lots." << endl;
+        return;
+    }
+    
+    cout << fixed << setprecision(2);
+    cout << "\nSymbol\tBought\t\tShares\tCost/Share\tCost Basis" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    for (int id : order) {
+        for (const TaxLot& lot : lots[id]) {
+            if (lot.remaining == 0) continue;
+            cout << symbols.name(id) << "\t" << DateUtil::formatDate(lot.date) << "\t"
+                 << lot.remaining << "\t$" << lot.costPerShare << "\t\t$"
+                 << lot.remaining * lot.costPerShare << endl;
+        }
+    }
+}
+
+void TaxLotEngine::displayRealizedGains() const {
+    cout << "\n=== Realized Gains (" << lotMethodName(method) << ") ===" << endl;
+    if (gains.empty()) {
+        cout << "No sells yet." << endl;
+        return;
+    }
+    
+    // Most recent rows only; totals cover all of them
+    size_t first = (gains.size() > (size_t)MAX_GAIN_ROWS) ? gains.size() - MAX_GAIN_ROWS : 0;
+    if (first > 0) {
+        cout << "(last " << MAX_GAIN_ROWS << " of " << gains.size() << " lot closings)" << endl;
+    }
+    
+    cout << fixed << setprecision(2);
+    cout << "\nSymbol\tBought\t\tSold\t\tShares\tCost\t\tProceeds\tGain\t\tTerm" << endl;
+    cout << "----------------------------------------------------------------------------------------------------" << endl;
+    for (size_t i = first; i < gains.size(); i++) {
+        const RealizedGain& g = gains[i];
+        cout << ledger->getSymbol(g.sellRow) << "\t" << DateUtil::formatDate(g.buyDate) << "\t"
+             << DateUtil::formatDate(g.sellDate) << "\t" << g.quantity << "\t$" << g.costBasis
+             << "\t$" << g.proceeds << "\t$" << g.gain << "\t" << (g.longTerm ? "Long" : "Short");
+        if (g.disallowed > 0.0) {
+            cout << "\tWash sale: $" << g.disallowed << " deferred";
+        }
+        cout << endl;
+    }
+    
+    cout << "\nShort-term gain: $" << getShortTermGain() << endl;
+    cout << "Long-term gain: $" << getLongTermGain() << endl;
+    cout << "Disallowed (wash sale) losses: $" << getDisallowedLoss() << endl;
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+// ThreadPool.cpp
+#include "../include/ThreadPool.h"
+
+using namespace std;
+
+// Which pool/worker the current thread belongs to (for local submits)
+static thread_local const ThreadPool* currentPool = nullptr;
+static thread_local int currentWorker = -1;
+
+// Constructor: start the workers
+ThreadPool::ThreadPool(int numThreads) : queued(0), nextQueue(0) {
+    pending = 0;
+    stopping = false;
+    
+    if (numThreads <= 0) {
+        numThreads = defaultThreads();
+    }
+    
+    for (int i = 0; i < numThreads; i++) {
+        queues.emplace_back(new WorkerQueue());
+    }
+    for (int i = 0; i < numThreads; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+// Destructor: finish queued work, then stop the workers
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(stateMutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(function<void()> task) {
+    // Workers keep their own subtasks local, others are spread round-robin
+    int target;
+    if (currentPool == this) {
+        target = currentWorker;
+    } else {
+        target = nextQueue.fetch_add(1, memory_order_relaxed) % queues.size();
+    }
+    
+    {
+        lock_guard<mutex> lock(stateMutex);
+        pending++;
+    }
+    
+    {
+        lock_guard<mutex> lock(queues[target]->lock);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+    queued.fetch_add(1);
+    
+    // Taking the lock orders this wake-up after a worker's last check
+    {
+        lock_guard<mutex> lock(stateMutex);
+    }
+    taskAvailable.notify_one();
+}
+
+void ThreadPool::waitAll() {
+    unique_lock<mutex> lock(stateMutex);
+    allDone.wait(lock, [this] { return pending == 0; });
+}
+
+int ThreadPool::size() const {
+    return workers.size();
+}
+
+int ThreadPool::defaultThreads() {
+    int threads = thread::hardware_concurrency();
+    return threads > 0 ? threads : 1;
+}
+
+// Take the newest local task, or steal the oldest task of another worker
+bool ThreadPool::popTask(int index, function<void()>& task) {
+    {
+        WorkerQueue& own = *queues[index];
+        lock_guard<mutex> lock(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    
+    int numQueues = queues.size();
+    for (int offset = 1; offset < numQueues; offset++) {
+        WorkerQueue& victim = *queues[(index + offset) % numQueues];
+        lock_guard<mutex> lock(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+// Worker: run tasks until the pool is stopped and nothing is left
+void ThreadPool::workerLoop(int index) {
+    currentPool = this;
+    currentWorker = index;
+    
+    while (true) {
+        function<void()> task;
+        
+        if (!popTask(index, task)) {
+            unique_lock<mutex> lock(stateMutex);
+            taskAvailable.wait(lock, [this] { return stopping || queued.load() > 0; });
+            
+            if (stopping && queued.load() == 0) {
+                return;
+            }
+            continue;
+        }
+        
+        task();
+        task = nullptr;  // Release captures before reporting completion
+        
+        {
+            lock_guard<mutex> lock(stateMutex);
+            pending--;
+            if (pending == 0) {
+                allDone.notify_all();
+            }
+        }
+    }
+}
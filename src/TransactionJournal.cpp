@@ -0,0 +1,227 @@
+// TransactionJournal.cpp
+#include "../include/TransactionJournal.h"
+#include "../include/MappedFile.h"
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+using namespace std;
+
+static const char JOURNAL_MAGIC[8] = {'Q', 'L', 'J', 'R', 'N', 'L', '0', '1'};
+static const uint32_t JOURNAL_VERSION = 2;
+
+static_assert(sizeof(JournalHeader) == 32, "journal header must stay 32 bytes");
+
+// Record layout: [payload bytes u32][checksum u32] then the payload:
+// type u8, quantity i32, amount f64, date i32, symbol (u8 length + bytes)
+static const size_t RECORD_PREFIX = 8;
+static const size_t RECORD_FIXED = 1 + 4 + 8 + 4 + 1;
+static const size_t MAX_RECORD = RECORD_PREFIX + RECORD_FIXED + 255;
+
+// FNV-1a
+uint32_t TransactionJournal::checksum(const char* data, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Constructor
+TransactionJournal::TransactionJournal() {
+    fd = -1;
+    unsyncedRecords = 0;
+}
+
+TransactionJournal::~TransactionJournal() {
+    close();
+}
+
+string TransactionJournal::journalPath(const string& snapshotFile) {
+    return snapshotFile + ".qlj";
+}
+
+bool TransactionJournal::lock(const string& filename) {
+    close();
+    
+    // No O_TRUNC: the file may belong to whoever holds the lock
+    fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        int error = errno;      // EWOULDBLOCK when someone else holds it
+        ::close(fd);
+        fd = -1;
+        errno = error;
+        return false;
+    }
+    path = filename;
+    return true;
+}
+
+bool TransactionJournal::create(uint64_t generation) {
+    if (fd < 0) return false;
+    
+    JournalHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+    header.version = JOURNAL_VERSION;
+    header.generation = generation;
+    
+    unsyncedRecords = 0;
+    if (ftruncate(fd, 0) != 0 ||
+        write(fd, &header, sizeof(header)) != (ssize_t)sizeof(header) || fsync(fd) != 0) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool TransactionJournal::open(uint64_t generation, vector<JournalRecord>& records) {
+    records.clear();
+    if (fd < 0) return false;
+    
+    size_t validBytes = 0;
+    {
+        MappedFile file;
+        if (!file.open(path) || file.size() < sizeof(JournalHeader)) {
+            return false;
+        }
+        
+        JournalHeader header;
+        memcpy(&header, file.begin(), sizeof(header));
+        if (memcmp(header.magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0 ||
+            header.version != JOURNAL_VERSION || header.generation != generation) {
+            return false;
+        }
+        
+        // Read records up to the end or the first torn one
+        validBytes = sizeof(JournalHeader);
+        JournalRecord record;
+        while (validBytes < file.size()) {
+            size_t used = decode(file.begin() + validBytes, file.size() - validBytes, record);
+            if (used == 0) break;
+            records.push_back(record);
+            validBytes += used;
+        }
+    }
+    
+    // Drop a torn tail so new records follow the last good one
+    off_t fileBytes = lseek(fd, 0, SEEK_END);
+    if (fileBytes > (off_t)validBytes) {
+        if (ftruncate(fd, validBytes) != 0 || fsync(fd) != 0) {
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t TransactionJournal::encode(const JournalRecord& record, char* out) {
+    uint8_t symbolLength = min<size_t>(record.symbol.size(), 255);
+    int32_t quantity = record.quantity;
+    int32_t date = record.date;
+    
+    char* p = out + RECORD_PREFIX;
+    *p++ = static_cast<char>(record.type);
+    memcpy(p, &quantity, sizeof(quantity));
+    p += sizeof(quantity);
+    memcpy(p, &record.amount, sizeof(record.amount));
+    p += sizeof(record.amount);
+    memcpy(p, &date, sizeof(date));
+    p += sizeof(date);
+    *p++ = static_cast<char>(symbolLength);
+    memcpy(p, record.symbol.data(), symbolLength);
+    p += symbolLength;
+    
+    uint32_t payload = p - (out + RECORD_PREFIX);
+    uint32_t sum = checksum(out + RECORD_PREFIX, payload);
+    memcpy(out, &payload, sizeof(payload));
+    memcpy(out + 4, &sum, sizeof(sum));
+    return RECORD_PREFIX + payload;
+}
+
+size_t TransactionJournal::decode(const char* data, size_t available, JournalRecord& record) {
+    if (available < RECORD_PREFIX) return 0;
+    
+    uint32_t payload, sum;
+    memcpy(&payload, data, sizeof(payload));
+    memcpy(&sum, data + 4, sizeof(sum));
+    if (payload < RECORD_FIXED || payload > MAX_RECORD - RECORD_PREFIX || RECORD_PREFIX + payload > available) {
+        return 0;
+    }
+    
+    const char* p = data + RECORD_PREFIX;
+    const char* end = p + payload;
+    if (checksum(p, payload) != sum) return 0;
+    
+    uint8_t type = static_cast<uint8_t>(*p++);
+    if (type < JOURNAL_CASH || type > JOURNAL_SELL) return 0;
+    record.type = static_cast<JournalType>(type);
+    
+    int32_t quantity, date;
+    memcpy(&quantity, p, sizeof(quantity));
+    p += sizeof(quantity);
+    memcpy(&record.amount, p, sizeof(record.amount));
+    p += sizeof(record.amount);
+    memcpy(&date, p, sizeof(date));
+    p += sizeof(date);
+    record.quantity = quantity;
+    record.date = date;
+    
+    uint8_t symbolLength = static_cast<uint8_t>(*p++);
+    if (p + symbolLength != end) return 0;
+    record.symbol.assign(p, symbolLength);
+    
+    return RECORD_PREFIX + payload;
+}
+
+bool TransactionJournal::append(const JournalRecord& record) {
+    if (fd < 0) return false;
+    
+    char buffer[MAX_RECORD];
+    size_t length = encode(record, buffer);
+    if (write(fd, buffer, length) != (ssize_t)length) {
+        return false;
+    }
+    
+    if (++unsyncedRecords >= JOURNAL_SYNC_RECORDS) {
+        return sync();
+    }
+    return true;
+}
+
+bool TransactionJournal::sync() {
+    if (fd < 0) return false;
+    
+    unsyncedRecords = 0;
+    return fsync(fd) == 0;
+}
+
+void TransactionJournal::close() {
+    if (fd >= 0) {
+        if (unsyncedRecords > 0) {
+            fsync(fd);
+        }
+        ::close(fd);
+    }
+    fd = -1;
+    unsyncedRecords = 0;
+    path.clear();
+}
+
+bool TransactionJournal::isOpen() const {
+    return fd >= 0;
+}
+
+void TransactionJournal::swap(TransactionJournal& other) {
+    std::swap(fd, other.fd);
+    std::swap(unsyncedRecords, other.unsyncedRecords);
+    path.swap(other.path);
+}
\ No newline at end of file
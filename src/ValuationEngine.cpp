@@ -0,0 +1,106 @@
+// ValuationEngine.cpp
+#include "../include/ValuationEngine.h"
+#include "../include/Portfolio.h"
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+
+// Constructor
+ValuationEngine::ValuationEngine() {
+    offsets.push_back(0);
+}
+
+void ValuationEngine::updatePrices(const StockRegistry& stocks) {
+    if (stocks.idLimit() > (int)prices.size()) {
+        prices.resize(stocks.idLimit(), 0.0);
+    }
+    for (int id = 0; id < stocks.idLimit(); id++) {
+        const Stock* stock = stocks.get(id);
+        int n = (stock != nullptr) ? stock->getDataSize() : 0;
+        if (n > 0) {
+            prices[id] = stock->getClosePrice(n - 1);
+        }
+    }
+}
+
+void ValuationEngine::updatePrice(const string& symbol, double close) {
+    int id = SymbolTable::global().intern(symbol);
+    if (id >= (int)prices.size()) {
+        prices.resize(id + 1, 0.0);
+    }
+    prices[id] = close;
+}
+
+void ValuationEngine::setPortfolios(const vector<Portfolio*>& list) {
+    portfolios.assign(list.begin(), list.end());
+    offsets.assign(1, 0);
+    positionSymbols.clear();
+    quantities.clear();
+    costBases.clear();
+    
+    for (const Portfolio* portfolio : portfolios) {
+        for (const Holding& h : portfolio->getHoldings()) {
+            positionSymbols.push_back(h.symbolId);
+            quantities.push_back(h.quantity);
+            costBases.push_back(h.quantity * h.avgCost);
+        }
+        offsets.push_back(positionSymbols.size());
+    }
+    
+    // New symbols start without a price
+    prices.resize(SymbolTable::global().size(), 0.0);
+    marketValues.assign(positionSymbols.size(), 0.0);
+    valuations.assign(portfolios.size(), Valuation{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0});
+}
+
+void ValuationEngine::revalue() {
+    // Mark all positions in one branch-free pass (unpriced ones at cost)
+    int numPositions = positionSymbols.size();
+    const int* ids = positionSymbols.data();
+    const double* price = prices.data();
+    for (int k = 0; k < numPositions; k++) {
+        double p = price[ids[k]];
+        marketValues[k] = (p > 0.0) ? quantities[k] * p : costBases[k];
+    }
+    
+    // Total each portfolio's slice
+    for (size_t p = 0; p < portfolios.size(); p++) {
+        Valuation& v = valuations[p];
+        v.marketValue = 0.0;
+        v.costBasis = 0.0;
+        v.unpricedHoldings = 0;
+        for (int k = offsets[p]; k < offsets[p + 1]; k++) {
+            v.marketValue += marketValues[k];
+            v.costBasis += costBases[k];
+            v.unpricedHoldings += (price[ids[k]] > 0.0) ? 0 : 1;
+        }
+        v.unrealizedPnL = v.marketValue - v.costBasis;
+        v.realizedPnL = portfolios[p]->getRealizedPnL();
+        v.cash = portfolios[p]->getCashBalance();
+        v.totalValue = v.marketValue + v.cash;
+    }
+}
+
+double ValuationEngine::getPrice(int portfolio, int k) const {
+    return prices[positionSymbols[offsets[portfolio] + k]];
+}
+
+double ValuationEngine::getMarketValue(int portfolio, int k) const {
+    return marketValues[offsets[portfolio] + k];
+}
+
+void ValuationEngine::displayValuations() const {
+    cout << fixed << setprecision(2);
+    cout << "\nPortfolio\tCash\t\tMarket Value\tTotal\t\tUnrealized\tRealized" << endl;
+    cout << "--------------------------------------------------------------------------------------" << endl;
+    for (size_t p = 0; p < portfolios.size(); p++) {
+        const Valuation& v = valuations[p];
+        cout << portfolios[p]->getName() << "\t\t$" << v.cash << "\t$" << v.marketValue << "\t$"
+             << v.totalValue << "\t$" << v.unrealizedPnL << "\t$" << v.realizedPnL;
+        if (v.unpricedHoldings > 0) {
+            cout << "\t(" << v.unpricedHoldings << " at cost)";
+        }
+        cout << endl;
+    }
+}
\ No newline at end of file
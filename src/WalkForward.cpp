@@ -0,0 +1,188 @@
+// WalkForward.cpp
+#include "../include/WalkForward.h"
+#include "../include/Backtester.h"
+#include "../include/ThreadPool.h"
+#include "../include/SimdKernels.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+// Helper: train on [start, start + train), test on the next `test` days
+vector<WalkForwardWindow> WalkForward::makeWindows(int numDays, int trainDays, int testDays) {
+    vector<WalkForwardWindow> windows;
+    if (trainDays <= 0 || testDays <= 0) return windows;
+    
+    for (int start = 0; start + trainDays < numDays; start += testDays) {
+        WalkForwardWindow window;
+        window.trainStart = start;
+        window.trainEnd = start + trainDays;
+        window.testStart = window.trainEnd;
+        window.testEnd = min(window.testStart + testDays, numDays);
+        window.trainReturn = 0.0;
+        window.testReturn = 0.0;
+        window.testTrades = 0;
+        window.valid = false;
+        windows.push_back(window);
+    }
+    return windows;
+}
+
+WalkForwardResult WalkForward::run(Stock* stock, const ParameterGrid& grid, StrategyFactory factory,
+                                   int trainDays, int testDays, double initialCash,
+                                   int numThreads, const ExecutionModel* execution) {
+    WalkForwardResult result;
+    result.windows = makeWindows(stock->getDataSize(), trainDays, testDays);
+    result.firstTestDay = result.windows.empty() ? 0 : result.windows[0].testStart;
+    result.startingCash = initialCash;
+    result.finalValue = initialCash;
+    result.totalReturn = 0.0;
+    result.maxDrawdown = 0.0;
+    
+    vector<WalkForwardWindow>& windows = result.windows;
+    long long combinations = grid.size();
+    int numWindows = windows.size();
+    if (numWindows == 0 || combinations == 0) return result;
+    
+    // Train return of every (combination, window), combination-major
+    vector<double> trainReturns(combinations * numWindows, 0.0);
+    vector<char> validCombos(combinations, 0);
+    vector<vector<int8_t>> testSignals(numWindows);
+    
+    {
+        ThreadPool pool(numThreads);
+        
+        // Phase 1: one task per batch of combinations, each signal array
+        // is built once and reused for all train windows
+        const long long batchSize = 16;
+        for (long long first = 0; first < combinations; first += batchSize) {
+            long long last = min(first + batchSize, combinations);
+            
+            pool.submit([&, first, last] {
+                Backtester backtester(stock, nullptr, initialCash);
+                backtester.setExecutionModel(execution);
+                vector<int8_t> signals;
+                
+                for (long long c = first; c < last; c++) {
+                    Strategy* strategy = factory(grid.at(c));
+                    if (strategy == nullptr) continue;
+                    
+                    strategy->generateSignals(stock, signals);
+                    backtester.setStrategy(strategy);
+                    backtester.setSignals(&signals);
+                    
+                    for (int w = 0; w < numWindows; w++) {
+                        backtester.setRange(windows[w].trainStart, windows[w].trainEnd);
+                        backtester.run(false);
+                        trainReturns[c * numWindows + w] = backtester.getTotalReturn();
+                    }
+                    validCombos[c] = 1;
+                    
+                    delete strategy;
+                }
+            });
+        }
+        pool.waitAll();
+        
+        // Pick the best combination per window (ties keep grid order)
+        for (int w = 0; w < numWindows; w++) {
+            long long best = -1;
+            for (long long c = 0; c < combinations; c++) {
+                if (validCombos[c] && (best < 0 || trainReturns[c * numWindows + w] > trainReturns[best * numWindows + w])) {
+                    best = c;
+                }
+            }
+            if (best >= 0) {
+                windows[w].valid = true;
+                windows[w].bestParams = grid.at(best);
+                windows[w].trainReturn = trainReturns[best * numWindows + w];
+            }
+        }
+        
+        // Phase 2: signals of each window's winner, in parallel
+        for (int w = 0; w < numWindows; w++) {
+            if (!windows[w].valid) continue;
+            pool.submit([&, w] {
+                Strategy* strategy = factory(windows[w].bestParams);
+                strategy->generateSignals(stock, testSignals[w]);
+                delete strategy;
+            });
+        }
+        pool.waitAll();
+    }
+    
+    // Phase 3: test windows in order, each starting with the capital the
+    // previous one ended with (cheap: one backtest per window)
+    double capital = initialCash;
+    result.equityCurve.reserve(windows.back().testEnd - result.firstTestDay);
+    
+    for (int w = 0; w < numWindows; w++) {
+        WalkForwardWindow& window = windows[w];
+        int testLength = window.testEnd - window.testStart;
+        
+        if (!window.valid) {
+            // Nothing to trade: stay in cash
+            result.equityCurve.insert(result.equityCurve.end(), testLength, capital);
+            continue;
+        }
+        
+        Strategy* strategy = factory(window.bestParams);
+        Backtester backtester(stock, strategy, capital);
+        backtester.setExecutionModel(execution);
+        backtester.setSignals(&testSignals[w]);
+        backtester.setRange(window.testStart, window.testEnd);
+        backtester.run(false);
+        
+        window.testReturn = backtester.getTotalReturn();
+        window.testTrades = backtester.getNumTrades();
+        
+        const Series& equity = backtester.getEquityCurve();
+        result.equityCurve.insert(result.equityCurve.end(), equity.begin(), equity.end());
+        capital = backtester.getFinalValue();
+        
+        delete strategy;
+    }
+    
+    result.finalValue = capital;
+    result.totalReturn = ((capital - initialCash) / initialCash) * 100.0;
+    result.maxDrawdown = SimdKernels::maxDrawdown(result.equityCurve.data(), result.equityCurve.size());
+    
+    return result;
+}
+
+void WalkForward::displayResults(const WalkForwardResult& result) {
+    cout << "\n========================================" << endl;
+    cout << "    WALK-FORWARD RESULTS" << endl;
+    cout << "========================================" << endl;
+    cout << "Windows: " << result.windows.size() << endl;
+    
+    if (result.windows.empty()) {
+        cout << "Not enough data for one train + test window." << endl;
+        return;
+    }
+    
+    cout << fixed << setprecision(2);
+    cout << "\nTest Days\tTrain\t\tTest\t\tParameters" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    
+    for (const WalkForwardWindow& window : result.windows) {
+        cout << window.testStart << "-" << window.testEnd - 1 << "\t\t";
+        if (!window.valid) {
+            cout << "-\t\t-\t\t(no valid parameters)" << endl;
+            continue;
+        }
+        cout << window.trainReturn << "%\t\t" << window.testReturn << "%\t\t";
+        for (const auto& param : window.bestParams) {
+            cout << param.first << "=" << param.second << " ";
+        }
+        cout << endl;
+    }
+    
+    cout << "\nOut-of-sample performance:" << endl;
+    cout << "  Starting Capital: $" << result.startingCash << endl;
+    cout << "  Final Value: $" << result.finalValue << endl;
+    cout << "  Total Return: " << result.totalReturn << "%" << endl;
+    cout << "  Max Drawdown: " << result.maxDrawdown << "%" << endl;
+    cout << "========================================" << endl;
+}
\ No newline at end of file
@@ -0,0 +1,216 @@
+// indicator_regression.cpp
+// Checks the rolling indicator kernels against the original O(n * period)
+// formulas on every CSV in a directory (default: data).
+#include "../include/Stock.h"
+#include "../include/StockLoader.h"
+#include <iostream>
+#include <cmath>
+
+using namespace std;
+
+static const double TOLERANCE = 1e-8;     // Relative to the value's magnitude
+
+// ===== Reference formulas (as computed before the rolling kernels) =====
+
+static vector<double> referenceSMA(const vector<double>& closes, int period) {
+    vector<double> out(closes.size(), 0.0);
+    for (int i = period - 1; i < (int)closes.size(); i++) {
+        double sum = 0.0;
+        for (int j = i - period + 1; j <= i; j++) {
+            sum += closes[j];
+        }
+        out[i] = sum / period;
+    }
+    return out;
+}
+
+static vector<double> referenceEMA(const vector<double>& closes, int period) {
+    vector<double> out(closes.size(), 0.0);
+    double multiplier = 2.0 / (period + 1);
+    for (int i = period - 1; i < (int)closes.size(); i++) {
+        if (i == period - 1) {
+            double sum = 0.0;
+            for (int j = 0; j < period; j++) {
+                sum += closes[j];
+            }
+            out[i] = sum / period;
+        } else {
+            out[i] = (closes[i] * multiplier) + (out[i - 1] * (1 - multiplier));
+        }
+    }
+    return out;
+}
+
+static vector<double> referenceRSI(const vector<double>& closes, int period) {
+    vector<double> out(closes.size(), 0.0);
+    for (int i = period; i < (int)closes.size(); i++) {
+        double sumGain = 0.0, sumLoss = 0.0;
+        for (int j = i - period + 1; j <= i; j++) {
+            double change = closes[j] - closes[j - 1];
+            if (change > 0) {
+                sumGain += change;
+            } else {
+                sumLoss += -change;
+            }
+        }
+        double avgGain = sumGain / period;
+        double avgLoss = sumLoss / period;
+        out[i] = (avgLoss == 0.0) ? 100.0 : 100.0 - (100.0 / (1.0 + avgGain / avgLoss));
+    }
+    return out;
+}
+
+// MACD line, signal and histogram (12/26/9)
+static void referenceMACD(const vector<double>& closes, vector<double>& macd,
+                          vector<double>& signal, vector<double>& histogram) {
+    int n = closes.size();
+    vector<double> ema12 = referenceEMA(closes, 12);
+    vector<double> ema26 = referenceEMA(closes, 26);
+    macd.assign(n, 0.0);
+    signal.assign(n, 0.0);
+    histogram.assign(n, 0.0);
+    
+    for (int i = 25; i < n; i++) {
+        macd[i] = ema12[i] - ema26[i];
+    }
+    
+    double multiplier = 2.0 / (9 + 1);
+    for (int i = 33; i < n; i++) {
+        if (i == 33) {
+            double sum = 0.0;
+            for (int j = 0; j < 9; j++) {
+                sum += macd[i - 8 + j];
+            }
+            signal[i] = sum / 9;
+        } else {
+            signal[i] = (macd[i] * multiplier) + (signal[i - 1] * (1 - multiplier));
+        }
+    }
+    
+    for (int i = 0; i < n; i++) {
+        histogram[i] = (signal[i] == 0.0) ? 0.0 : macd[i] - signal[i];
+    }
+}
+
+// Upper and lower Bollinger bands (population standard deviation)
+static void referenceBollinger(const vector<double>& closes, int period, double numStdDev,
+                               vector<double>& upper, vector<double>& lower) {
+    upper.assign(closes.size(), 0.0);
+    lower.assign(closes.size(), 0.0);
+    for (int i = period - 1; i < (int)closes.size(); i++) {
+        double sum = 0.0;
+        for (int j = i - period + 1; j <= i; j++) {
+            sum += closes[j];
+        }
+        double sma = sum / period;
+        
+        double variance = 0.0;
+        for (int j = i - period + 1; j <= i; j++) {
+            double diff = closes[j] - sma;
+            variance += diff * diff;
+        }
+        double stdDev = sqrt(variance / period);
+        upper[i] = sma + (numStdDev * stdDev);
+        lower[i] = sma - (numStdDev * stdDev);
+    }
+}
+
+static vector<double> referenceMomentum(const vector<double>& closes, int period) {
+    vector<double> out(closes.size(), 0.0);
+    for (int i = period; i < (int)closes.size(); i++) {
+        out[i] = ((closes[i] - closes[i - period]) / closes[i - period]) * 100.0;
+    }
+    return out;
+}
+
+// ===== Comparison =====
+
+// Largest error of a kernel series against the reference, relative to
+// max(1, |expected|); prints a line and returns whether it's in tolerance
+static bool compare(const string& label, const Series& actual, const vector<double>& expected) {
+    if (actual.size() != expected.size()) {
+        cout << "  ✗ " << label << ": " << actual.size() << " values, expected " << expected.size() << endl;
+        return false;
+    }
+    
+    double worst = 0.0;
+    int worstIndex = -1;
+    for (size_t i = 0; i < expected.size(); i++) {
+        double error = fabs(actual[i] - expected[i]) / max(1.0, fabs(expected[i]));
+        if (!(error <= worst)) {
+            worst = error;
+            worstIndex = i;
+        }
+    }
+    
+    bool ok = worst <= TOLERANCE;
+    cout << "  " << (ok ? "✓ " : "✗ ") << label << ": max relative error " << worst;
+    if (!ok) {
+        cout << " at bar " << worstIndex << " (" << actual[worstIndex] << " vs " << expected[worstIndex] << ")";
+    }
+    cout << endl;
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    string directory = (argc > 1) ? argv[1] : "data";
+    vector<string> files = StockLoader::findCSVFiles(directory);
+    if (files.empty()) {
+        cout << "Error: no CSV files in " << directory << endl;
+        return 1;
+    }
+    
+    Stock::setUseBinaryCache(false);
+    int failures = 0;
+    
+    for (const string& file : files) {
+        Stock stock("TEST", "TEST");
+        string message;
+        if (!stock.loadFromCSV(file, message)) {
+            cout << "Error: could not load " << file << ": " << message << endl;
+            failures++;
+            continue;
+        }
+        
+        const Series& closeSeries = stock.getBars().getCloses();
+        vector<double> closes(closeSeries.begin(), closeSeries.end());
+        cout << file << " (" << closes.size() << " bars)" << endl;
+        
+        for (int period : {20, 50}) {
+            failures += !compare("SMA(" + to_string(period) + ")",
+                                 stock.getIndicator("SMA", {(double)period}), referenceSMA(closes, period));
+        }
+        for (int period : {12, 26}) {
+            failures += !compare("EMA(" + to_string(period) + ")",
+                                 stock.getIndicator("EMA", {(double)period}), referenceEMA(closes, period));
+        }
+        failures += !compare("RSI(14)", stock.getIndicator("RSI", {14}), referenceRSI(closes, 14));
+        
+        vector<double> macd, signal, histogram;
+        referenceMACD(closes, macd, signal, histogram);
+        failures += !compare("MACD", stock.getIndicator("MACD", {12, 26}), macd);
+        failures += !compare("MACD signal", stock.getIndicator("MACD_SIGNAL", {12, 26, 9}), signal);
+        failures += !compare("MACD histogram", stock.getIndicator("MACD_HIST", {12, 26, 9}), histogram);
+        
+        vector<double> upper, lower;
+        referenceBollinger(closes, 20, 2.0, upper, lower);
+        failures += !compare("Bollinger upper", stock.getIndicator("BB_UPPER", {20, 2}), upper);
+        failures += !compare("Bollinger middle", stock.getIndicator("BB_MIDDLE", {20}), referenceSMA(closes, 20));
+        failures += !compare("Bollinger lower", stock.getIndicator("BB_LOWER", {20, 2}), lower);
+        
+        failures += !compare("Momentum(10)", stock.getIndicator("MOMENTUM", {10}), referenceMomentum(closes, 10));
+        
+        // Bad parameters give an empty series with the reason in message
+        string reason;
+        bool rejected = stock.getIndicator("SMA", {2.5}, reason).empty() && !reason.empty();
+        cout << "  " << (rejected ? "✓ " : "✗ ") << "SMA(2.5) rejected: " << reason << endl;
+        failures += !rejected;
+    }
+    
+    if (failures > 0) {
+        cout << "\n✗ " << failures << " indicator check(s) failed" << endl;
+        return 1;
+    }
+    cout << "\n✓ All indicators match the reference formulas" << endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+// tax_lot_test.cpp
+// Checks wash-sale handling in TaxLotEngine on small hand-made ledgers:
+// only the replacement shares carry the deferred loss, and their holding
+// period is the washed shares' plus their own.
+#include "../include/TaxLotEngine.h"
+#include <iostream>
+#include <cmath>
+
+using namespace std;
+
+static const int DAY0 = 19000;      // Days since epoch (2022-01-08)
+
+static int failures = 0;
+
+static void check(const string& label, bool ok) {
+    cout << "  " << (ok ? "✓ " : "✗ ") << label << endl;
+    if (!ok) failures++;
+}
+
+static bool near(double a, double b) {
+    return fabs(a - b) < 1e-9;
+}
+
+// Washed shares held 200 days, repurchased 20 days after the loss sale:
+// the replacement's holding period starts at day 220 - 200 = day 20, so
+// a sale 365 days after that is still short-term and one a day later is
+// long-term (counting from the original buy would make both long-term)
+static void testRepurchaseAfterSale() {
+    cout << "Repurchase 20 days after the loss sale" << endl;
+    
+    for (int extra = 0; extra < 2; extra++) {
+        Ledger ledger;
+        ledger.add("XYZ", TRADE_BUY, 100, 10.0, DAY0);
+        ledger.add("XYZ", TRADE_SELL, 100, 8.0, DAY0 + 200);      // $200 loss, washed
+        ledger.add("XYZ", TRADE_BUY, 100, 8.0, DAY0 + 220);
+        ledger.add("XYZ", TRADE_SELL, 100, 12.0, DAY0 + 20 + 365 + extra);
+        
+        TaxLotEngine engine(LOT_FIFO);
+        engine.rebuild(ledger);
+        const vector<RealizedGain>& gains = engine.getGains();
+        if (gains.size() != 2) {
+            check("two lot closings", false);
+            return;
+        }
+        
+        const RealizedGain& washed = gains[0];
+        const RealizedGain& replacement = gains[1];
+        string day = extra ? "366" : "365";
+        check("loss of the first sale is disallowed", near(washed.gain, -200.0) && near(washed.disallowed, 200.0));
+        check("replacement basis includes the deferred loss", near(replacement.costBasis, 1000.0));
+        check("replacement holding period starts at day 20", replacement.buyDate == DAY0 + 20);
+        check("sold on day " + day + " of the holding period: " + (extra ? "long-term" : "short-term"),
+              replacement.longTerm == (extra == 1));
+    }
+}
+
+// A partial wash against an earlier buy: only the matched shares are
+// adjusted, the rest keep the buy's price and date
+static void testPartialReplacement() {
+    cout << "Partial wash against an earlier buy" << endl;
+    
+    Ledger ledger;
+    ledger.add("XYZ", TRADE_BUY, 100, 10.0, DAY0);
+    ledger.add("XYZ", TRADE_BUY, 100, 5.0, DAY0 + 200);
+    ledger.add("XYZ", TRADE_SELL, 50, 5.0, DAY0 + 210);          // $250 loss on lot 1
+    
+    TaxLotEngine engine(LOT_FIFO);
+    engine.rebuild(ledger);
+    vector<TaxLot> open = engine.getOpenLots("XYZ");
+    if (open.size() != 3) {
+        check("three open lots", false);
+        return;
+    }
+    
+    check("unsold shares of the first buy unchanged",
+          open[0].row == 0 && open[0].remaining == 50 && near(open[0].costPerShare, 10.0));
+    check("50 replacement shares at $10 from day -10",
+          open[1].row == 1 && open[1].remaining == 50 && near(open[1].costPerShare, 10.0) &&
+          open[1].date == DAY0 + 200 - 210 && open[1].replacement);
+    check("other 50 shares at the buy price and date",
+          open[2].row == 1 && open[2].remaining == 50 && near(open[2].costPerShare, 5.0) &&
+          open[2].date == DAY0 + 200 && !open[2].replacement);
+}
+
+int main() {
+    testRepurchaseAfterSale();
+    testPartialReplacement();
+    
+    if (failures > 0) {
+        cout << "\n✗ " << failures << " tax lot check(s) failed" << endl;
+        return 1;
+    }
+    cout << "\n✓ All tax lot checks passed" << endl;
+    return 0;
+}
\ No newline at end of file